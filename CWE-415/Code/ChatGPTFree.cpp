@@ -1,5 +1,15 @@
+// Usage: ./bank [--thread-per-txn] [--quiet] [--seed N]
+//   Transactions run on a pool of one worker per core by default;
+//   --thread-per-txn spawns one thread per transaction (the original
+//   design, kept for comparison). --quiet drops the per-transaction lines.
+//   --seed fixes the random transactions: each batch (or, per thread,
+//   each transaction) draws from a generator seeded with (N, its index).
+//   With several workers only the order they land in still varies.
+
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <time.h>
@@ -14,63 +24,230 @@ int accounts[NUM_ACCOUNTS];
 // Mutex lock for each account
 pthread_mutex_t account_locks[NUM_ACCOUNTS];
 
-// Thread function
-void* transaction(void* arg) {
-    int account = rand() % NUM_ACCOUNTS;
-    int amount = rand() % MAX_TRANSACTION + 1;
-    int action = rand() % 2; // 0 = deposit, 1 = withdraw
+int quiet = 0;
+
+// Per-thread xoshiro256** generator; rng_below() uses Lemire's bounded method.
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// splitmix64 expansion of (seed, stream) into the 256-bit state
+static void rng_seed(Rng *r, uint64_t seed, uint64_t stream) {
+    uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        r->s[i] = z ^ (z >> 31);
+    }
+}
+
+static inline uint64_t rng_next(Rng *r) {
+    uint64_t *s = r->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+// Uniform integer in [0, n), n > 0
+static inline uint32_t rng_below(Rng *r, uint32_t n) {
+    uint64_t m = (rng_next(r) >> 32) * n;
+    if ((uint32_t)m < n) {
+        uint32_t threshold = -n % n;
+        while ((uint32_t)m < threshold) m = (rng_next(r) >> 32) * n;
+    }
+    return (uint32_t)(m >> 32);
+}
+
+uint64_t base_seed;
+
+// One random deposit or withdrawal
+void run_transaction(Rng* rng) {
+    int account = (int)rng_below(rng, NUM_ACCOUNTS);
+    int amount = (int)rng_below(rng, MAX_TRANSACTION) + 1;
+    int action = (int)rng_below(rng, 2); // 0 = deposit, 1 = withdraw
 
     pthread_mutex_lock(&account_locks[account]);
 
     if (action == 0) {
         // Deposit
         accounts[account] += amount;
-        printf("Thread %lu deposited $%d into Account %d | New Balance: $%d\n",
-               pthread_self(), amount, account, accounts[account]);
+        if (!quiet)
+            printf("Thread %lu deposited $%d into Account %d | New Balance: $%d\n",
+                   pthread_self(), amount, account, accounts[account]);
     } else {
         // Withdraw (only if sufficient funds)
         if (accounts[account] >= amount) {
             accounts[account] -= amount;
-            printf("Thread %lu withdrew $%d from Account %d | New Balance: $%d\n",
-                   pthread_self(), amount, account, accounts[account]);
-        } else {
+            if (!quiet)
+                printf("Thread %lu withdrew $%d from Account %d | New Balance: $%d\n",
+                       pthread_self(), amount, account, accounts[account]);
+        } else if (!quiet) {
             printf("Thread %lu failed withdrawal of $%d from Account %d | Insufficient Funds ($%d)\n",
                    pthread_self(), amount, account, accounts[account]);
         }
     }
 
     pthread_mutex_unlock(&account_locks[account]);
+}
+
+// Thread function
+void* transaction(void* arg) {
+    Rng rng;
+    rng_seed(&rng, base_seed, (uint64_t)(intptr_t)arg);
+    run_transaction(&rng);
     pthread_exit(NULL);
 }
 
-int main() {
-    int numTransactions;
+// Worker pool: a fixed set of threads (one per core) takes batches of
+// transactions from a bounded queue, instead of one thread per transaction.
+#define BATCH_SIZE 1024     // transactions per work item
+#define QUEUE_CAPACITY 64   // work items buffered between main and the pool
+#define MAX_WORKERS 256
 
-    srand(time(NULL));
+// A batch of transactions. index numbers the batch in submission order and
+// seeds its generator; count 0 tells the worker that takes it to exit.
+typedef struct {
+    int index;
+    int count;
+} WorkItem;
 
-    printf("Enter number of transaction simulations (threads): ");
-    scanf("%d", &numTransactions);
+// Bounded multi-producer/multi-consumer queue of batches.
+typedef struct {
+    WorkItem items[QUEUE_CAPACITY];
+    int head;
+    int count;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+} WorkQueue;
 
-    pthread_t threads[numTransactions];
+WorkQueue work_queue = {
+    {{0, 0}}, 0, 0,
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+};
 
-    // Initialize accounts and mutexes
-    for (int i = 0; i < NUM_ACCOUNTS; i++) {
-        accounts[i] = INITIAL_BALANCE;
-        pthread_mutex_init(&account_locks[i], NULL);
+void queue_push(WorkQueue* q, WorkItem item) {
+    pthread_mutex_lock(&q->lock);
+    while (q->count == QUEUE_CAPACITY)
+        pthread_cond_wait(&q->not_full, &q->lock);
+    q->items[(q->head + q->count) % QUEUE_CAPACITY] = item;
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+}
+
+WorkItem queue_pop(WorkQueue* q) {
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0)
+        pthread_cond_wait(&q->not_empty, &q->lock);
+    WorkItem item = q->items[q->head];
+    q->head = (q->head + 1) % QUEUE_CAPACITY;
+    q->count--;
+    pthread_cond_signal(&q->not_full);
+    pthread_mutex_unlock(&q->lock);
+    return item;
+}
+
+void* pool_worker(void* arg) {
+    (void)arg;
+    Rng rng;
+    for (;;) {
+        WorkItem item = queue_pop(&work_queue);
+        if (item.count == 0) break;
+        rng_seed(&rng, base_seed, (uint64_t)item.index);
+        for (int i = 0; i < item.count; i++) run_transaction(&rng);
     }
+    return NULL;
+}
 
-    // Create threads
-    for (int i = 0; i < numTransactions; i++) {
-        if (pthread_create(&threads[i], NULL, transaction, NULL) != 0) {
+// Runs numTransactions on a pool of numWorkers threads. Returns 0 on success.
+int run_pool(int numTransactions, int numWorkers) {
+    pthread_t workers[MAX_WORKERS];
+    for (int i = 0; i < numWorkers; i++) {
+        if (pthread_create(&workers[i], NULL, pool_worker, NULL) != 0) {
             perror("Failed to create thread");
             return 1;
         }
     }
+    int batch = 0;
+    for (int left = numTransactions; left > 0; left -= BATCH_SIZE) {
+        WorkItem item = {batch++, left < BATCH_SIZE ? left : BATCH_SIZE};
+        queue_push(&work_queue, item);
+    }
+    WorkItem stop = {0, 0};
+    for (int i = 0; i < numWorkers; i++) queue_push(&work_queue, stop);
+    for (int i = 0; i < numWorkers; i++) pthread_join(workers[i], NULL);
+    return 0;
+}
 
-    // Join threads
+// Original mode: one thread per transaction.
+int run_thread_per_transaction(int numTransactions) {
+    pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t) * (size_t)(numTransactions > 0 ? numTransactions : 1));
+    if (!threads) {
+        perror("malloc");
+        return 1;
+    }
+    for (int i = 0; i < numTransactions; i++) {
+        if (pthread_create(&threads[i], NULL, transaction, (void*)(intptr_t)i) != 0) {
+            perror("Failed to create thread");
+            free(threads);
+            return 1;
+        }
+    }
     for (int i = 0; i < numTransactions; i++) {
         pthread_join(threads[i], NULL);
     }
+    free(threads);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int numTransactions;
+    int threadPerTransaction = 0;
+
+    base_seed = (uint64_t)time(NULL) ^ (uint64_t)getpid();
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--thread-per-txn") == 0) threadPerTransaction = 1;
+        else if (strcmp(argv[i], "--quiet") == 0) quiet = 1;
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) base_seed = strtoull(argv[++i], NULL, 10);
+        else {
+            fprintf(stderr, "Usage: %s [--thread-per-txn] [--quiet] [--seed N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("Enter number of transaction simulations (threads): ");
+    scanf("%d", &numTransactions);
+
+    // Initialize accounts and mutexes
+    for (int i = 0; i < NUM_ACCOUNTS; i++) {
+        accounts[i] = INITIAL_BALANCE;
+        pthread_mutex_init(&account_locks[i], NULL);
+    }
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int numWorkers = cores < 1 ? 1 : cores > MAX_WORKERS ? MAX_WORKERS : (int)cores;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int failed = threadPerTransaction ? run_thread_per_transaction(numTransactions)
+                                      : run_pool(numTransactions, numWorkers);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (failed) return 1;
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
 
     // Final account balances
     printf("\nFinal Account Balances:\n");
@@ -79,5 +256,13 @@ int main() {
         pthread_mutex_destroy(&account_locks[i]);
     }
 
+    if (threadPerTransaction)
+        printf("\n%d transactions, one thread each, in %.3f s (%.0f/sec)\n",
+               numTransactions, elapsed, elapsed > 0 ? numTransactions / elapsed : 0.0);
+    else
+        printf("\n%d transactions on %d pool workers in %.3f s (%.0f/sec)\n",
+               numTransactions, numWorkers, elapsed, elapsed > 0 ? numTransactions / elapsed : 0.0);
+    printf("Seed: %llu\n", (unsigned long long)base_seed);
+
     return 0;
 }
\ No newline at end of file
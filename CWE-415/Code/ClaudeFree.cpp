@@ -5,7 +5,23 @@
  * using POSIX threads (pthreads) with mutex locks for thread safety.
  *
  * Compile:  gcc -o bank_simulation bank_simulation.c -lpthread
- * Run:      ./bank_simulation
+ *           (add -DPACKED_ACCOUNTS for the unpadded account layout)
+ * Run:      ./bank_simulation [--log FILE] [--seed N] [num_threads [chunk_size]]
+ *           ./bank_simulation --view FILE [N]
+ *
+ * Workers claim transactions from the shared counter in chunks of
+ * chunk_size (default 1024, at most the transaction count) with one
+ * compare-and-swap, instead of taking a lock per transaction.
+ *
+ * Every transaction is logged: each worker pushes entries into its own
+ * single-producer ring, and a background writer thread drains the rings to
+ * a binary log file (default bank_transactions.log). --view prints the last
+ * N (default 20) transactions from such a file.
+ *
+ * Each claimed chunk draws from its own xoshiro256** generator, seeded from
+ * the run's seed and the chunk's index, so --seed N fixes the transactions
+ * whichever worker runs them. With several threads the order they land in
+ * (and so which withdrawals fail) is still up to the scheduler.
  */
 
 #include <stdio.h>
@@ -13,18 +29,49 @@
 #include <pthread.h>
 #include <time.h>
 #include <string.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <sched.h>
+#include <unistd.h>
+
+/* Builds as C11 or as C++: C++ takes the same atomic names from <atomic>. */
+#ifdef __cplusplus
+#include <atomic>
+using std::atomic_int;
+using std::atomic_size_t;
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
+#else
+#include <stdatomic.h>
+#endif
 
 /* ─── Constants ─────────────────────────────────────────────── */
 #define NUM_ACCOUNTS     10
-#define NUM_THREADS      4          /* worker threads */
+#define NUM_THREADS      4          /* default worker threads */
+#define MAX_THREADS      256
+#define DEFAULT_CHUNK    1024       /* transactions claimed per compare-and-swap */
 #define INITIAL_BALANCE  1000.00    /* starting balance per account ($) */
 #define MAX_AMOUNT       500.00     /* maximum single transaction amount ($) */
 
+#define CACHE_LINE       64
+
+/* Each account starts on its own cache line, so threads working on
+ * different accounts never write to the same line. The statistics stay on
+ * that line: they are updated under the lock with the balance, so a split
+ * would only add a second line to every transaction.
+ * Build with -DPACKED_ACCOUNTS for the old packed layout (for comparison). */
+#ifdef PACKED_ACCOUNTS
+#define LINE_ALIGNED
+#else
+#define LINE_ALIGNED     alignas(CACHE_LINE)
+#endif
+
 /* ─── Shared State ──────────────────────────────────────────── */
 typedef struct {
+    LINE_ALIGNED pthread_mutex_t lock;
     double         balance;
     int            account_id;
-    pthread_mutex_t lock;
     int            total_deposits;
     int            total_withdrawals;
     int            failed_withdrawals;
@@ -32,89 +79,213 @@ typedef struct {
 
 Account accounts[NUM_ACCOUNTS];
 
-/* Remaining transactions counter (shared across threads) */
-int      transactions_remaining;
-pthread_mutex_t counter_lock = PTHREAD_MUTEX_INITIALIZER;
+/* Remaining transactions counter (shared across threads). Claims never
+ * take it below zero, so it cannot wrap however large claim_chunk is. */
+atomic_int transactions_remaining;
+int        claim_chunk = DEFAULT_CHUNK;
+
+/* ─── Transaction Log ───────────────────────────────────────── */
+/* File format: LOG_MAGIC, then one LogEntry per transaction in native
+ * byte order. Entries from different threads are interleaved in drain
+ * order; timestamp_ns (taken under the account lock) gives the real
+ * order. */
+#define LOG_MAGIC        "BANKLOG1"
+#define DEFAULT_LOG_FILE "bank_transactions.log"
+#define RING_SIZE        4096       /* entries per worker ring (power of 2) */
+#define LOG_DEPOSIT      0
+#define LOG_WITHDRAWAL   1
 
-/* Completed-transaction log (optional display) */
-#define LOG_SIZE 10000
 typedef struct {
-    int    thread_id;
-    int    account_id;
-    char   type[12];   /* "DEPOSIT" or "WITHDRAWAL" */
-    double amount;
-    double new_balance;
-    int    success;
+    int64_t  timestamp_ns;  /* CLOCK_MONOTONIC */
+    int32_t  thread_id;
+    int32_t  account_id;
+    double   amount;
+    double   new_balance;
+    uint8_t  type;          /* LOG_DEPOSIT or LOG_WITHDRAWAL */
+    uint8_t  success;
+    uint8_t  pad[6];
 } LogEntry;
 
-LogEntry txn_log[LOG_SIZE];
-int      log_index = 0;
-pthread_mutex_t log_lock = PTHREAD_MUTEX_INITIALIZER;
+/* One per worker: the worker only advances head, the writer only tail. */
+typedef struct {
+    alignas(CACHE_LINE) atomic_size_t head;
+    alignas(CACHE_LINE) atomic_size_t tail;
+    LogEntry entries[RING_SIZE];
+} LogRing;
+
+LogRing   *log_rings;           /* num_threads rings, indexed by tid - 1 */
+int        log_ring_count;
+FILE      *log_file;
+atomic_int log_done;            /* set once every worker has been joined */
+
+/* ─── Random Numbers ────────────────────────────────────────── */
+/* Per-worker xoshiro256** generator with Lemire range reduction. */
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/* splitmix64 expansion of (seed, stream) into the 256-bit state */
+static void rng_seed(Rng *r, uint64_t seed, uint64_t stream) {
+    uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        r->s[i] = z ^ (z >> 31);
+    }
+}
+
+static inline uint64_t rng_next(Rng *r) {
+    uint64_t *s = r->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+/* Uniform integer in [0, n), n > 0 */
+static inline uint32_t rng_below(Rng *r, uint32_t n) {
+    uint64_t m = (rng_next(r) >> 32) * n;
+    if ((uint32_t)m < n) {
+        uint32_t threshold = -n % n;
+        while ((uint32_t)m < threshold) m = (rng_next(r) >> 32) * n;
+    }
+    return (uint32_t)(m >> 32);
+}
+
+/* Uniform double in [0, 1) */
+static inline double rng_double(Rng *r) {
+    return (double)(rng_next(r) >> 11) / 9007199254740992.0;   /* 2^53 */
+}
+
+uint64_t base_seed;             /* --seed, or time ^ pid */
 
 /* ─── Helpers ───────────────────────────────────────────────── */
-/* Thread-safe random double in [0, max] */
-double rand_amount(unsigned int *seed) {
-    return ((double)rand_r(seed) / RAND_MAX) * MAX_AMOUNT;
+/* Random amount in [0, MAX_AMOUNT) */
+double rand_amount(Rng *rng) {
+    return rng_double(rng) * MAX_AMOUNT;
 }
 
-void log_transaction(int tid, int aid, const char *type,
+/* Appends to the calling worker's ring. Lock-free; waits only if the
+ * writer has fallen a whole ring behind. */
+void log_transaction(int tid, int aid, int type,
                      double amount, double bal, int ok) {
-    pthread_mutex_lock(&log_lock);
-    if (log_index < LOG_SIZE) {
-        txn_log[log_index].thread_id   = tid;
-        txn_log[log_index].account_id  = aid;
-        strncpy(txn_log[log_index].type, type, 11);
-        txn_log[log_index].type[11]    = '\0';
-        txn_log[log_index].amount      = amount;
-        txn_log[log_index].new_balance = bal;
-        txn_log[log_index].success     = ok;
-        log_index++;
-    }
-    pthread_mutex_unlock(&log_lock);
+    LogRing *ring = &log_rings[tid - 1];
+    size_t   head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    while (head - atomic_load_explicit(&ring->tail, memory_order_acquire) >= RING_SIZE)
+        sched_yield();
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    LogEntry *e     = &ring->entries[head & (RING_SIZE - 1)];
+    e->timestamp_ns = (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+    e->thread_id    = tid;
+    e->account_id   = aid;
+    e->amount       = amount;
+    e->new_balance  = bal;
+    e->type         = (uint8_t)type;
+    e->success      = (uint8_t)ok;
+    memset(e->pad, 0, sizeof(e->pad));
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
 }
 
-/* ─── Worker Thread ─────────────────────────────────────────── */
-void *worker(void *arg) {
-    int          tid  = *(int *)arg;
-    unsigned int seed = (unsigned int)(time(NULL) ^ (tid * 2654435761u));
+/* Moves everything currently in the rings to the log file. Returns the
+ * number of entries written. */
+static size_t drain_rings(void) {
+    size_t moved = 0;
+    for (int r = 0; r < log_ring_count; r++) {
+        LogRing *ring = &log_rings[r];
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        while (tail != head) {
+            /* Contiguous run up to the end of the ring */
+            size_t at  = tail & (RING_SIZE - 1);
+            size_t run = head - tail;
+            if (run > RING_SIZE - at) run = RING_SIZE - at;
+            fwrite(&ring->entries[at], sizeof(LogEntry), run, log_file);
+            tail  += run;
+            moved += run;
+        }
+        atomic_store_explicit(&ring->tail, tail, memory_order_release);
+    }
+    return moved;
+}
 
+/* Background writer: drains until log_done is set and the rings are empty. */
+void *log_writer(void *arg) {
+    (void)arg;
+    const struct timespec idle = {0, 200000};   /* 0.2 ms */
     while (1) {
-        /* Claim one transaction slot */
-        pthread_mutex_lock(&counter_lock);
-        if (transactions_remaining <= 0) {
-            pthread_mutex_unlock(&counter_lock);
-            break;
+        int done = atomic_load_explicit(&log_done, memory_order_acquire);
+        if (drain_rings() == 0) {
+            if (done) break;
+            nanosleep(&idle, NULL);
         }
-        transactions_remaining--;
-        pthread_mutex_unlock(&counter_lock);
-
-        /* Pick a random account and amount */
-        int    aid    = rand_r(&seed) % NUM_ACCOUNTS;
-        double amount = rand_amount(&seed);
-        int    is_dep = rand_r(&seed) % 2;   /* 0 = withdrawal, 1 = deposit */
+    }
+    return NULL;
+}
 
-        pthread_mutex_lock(&accounts[aid].lock);
+/* ─── Worker Thread ─────────────────────────────────────────── */
+void *worker(void *arg) {
+    int tid = *(int *)arg;
+    Rng rng;
 
-        if (is_dep) {
-            accounts[aid].balance += amount;
-            accounts[aid].total_deposits++;
-            log_transaction(tid, aid, "DEPOSIT",
-                            amount, accounts[aid].balance, 1);
-        } else {
-            if (accounts[aid].balance >= amount) {
-                accounts[aid].balance -= amount;
-                accounts[aid].total_withdrawals++;
-                log_transaction(tid, aid, "WITHDRAWAL",
+    while (1) {
+        /* Claim min(claim_chunk, remaining) transaction slots */
+        int before = atomic_load_explicit(&transactions_remaining,
+                                          memory_order_relaxed);
+        int claimed;
+        do {
+            if (before <= 0) break;
+            claimed = (before < claim_chunk) ? before : claim_chunk;
+        } while (!atomic_compare_exchange_weak_explicit(&transactions_remaining,
+                                                        &before, before - claimed,
+                                                        memory_order_relaxed,
+                                                        memory_order_relaxed));
+        if (before <= 0) break;
+
+        /* Chunks are cut from the top of the counter, so this numbers them
+         * from the last one claimed (index 0) up. */
+        rng_seed(&rng, base_seed, (uint64_t)((before - 1) / claim_chunk));
+        for (int t = 0; t < claimed; t++) {
+            /* Pick a random account and amount */
+            int    aid    = (int)rng_below(&rng, NUM_ACCOUNTS);
+            double amount = rand_amount(&rng);
+            int    is_dep = (int)rng_below(&rng, 2);   /* 0 = withdrawal, 1 = deposit */
+
+            pthread_mutex_lock(&accounts[aid].lock);
+
+            if (is_dep) {
+                accounts[aid].balance += amount;
+                accounts[aid].total_deposits++;
+                log_transaction(tid, aid, LOG_DEPOSIT,
                                 amount, accounts[aid].balance, 1);
             } else {
-                /* Insufficient funds – skip, but record attempt */
-                accounts[aid].failed_withdrawals++;
-                log_transaction(tid, aid, "WITHDRAWAL",
-                                amount, accounts[aid].balance, 0);
+                if (accounts[aid].balance >= amount) {
+                    accounts[aid].balance -= amount;
+                    accounts[aid].total_withdrawals++;
+                    log_transaction(tid, aid, LOG_WITHDRAWAL,
+                                    amount, accounts[aid].balance, 1);
+                } else {
+                    /* Insufficient funds – skip, but record attempt */
+                    accounts[aid].failed_withdrawals++;
+                    log_transaction(tid, aid, LOG_WITHDRAWAL,
+                                    amount, accounts[aid].balance, 0);
+                }
             }
-        }
 
-        pthread_mutex_unlock(&accounts[aid].lock);
+            pthread_mutex_unlock(&accounts[aid].lock);
+        }
     }
 
     return NULL;
@@ -175,37 +346,119 @@ void print_summary(int total_txns) {
     printf("  Final   total balance  : $%.2f\n\n", total_bal);
 }
 
-/* Print last N log entries */
-void print_log(int n) {
-    int start = log_index - n;
-    if (start < 0) start = 0;
+/* Print the last N entries (by timestamp) of a log file. Returns 0 on
+ * success, -1 if the file cannot be read. */
+int print_log(const char *path, int n) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    char magic[8];
+    if (fread(magic, 1, sizeof(magic), f) != sizeof(magic) ||
+        memcmp(magic, LOG_MAGIC, sizeof(magic)) != 0) {
+        fprintf(stderr, "%s: not a transaction log\n", path);
+        fclose(f);
+        return -1;
+    }
 
-    printf("  ── Last %d transactions ──\n", log_index - start);
+    /* last[] keeps the n newest entries seen so far, oldest first */
+    LogEntry *last  = (LogEntry *)malloc(sizeof(LogEntry) * (size_t)(n > 0 ? n : 1));
+    int       kept  = 0;
+    long      total = 0;
+    LogEntry  e;
+    while (last && fread(&e, sizeof(e), 1, f) == 1) {
+        total++;
+        if (kept == n && (n == 0 || e.timestamp_ns < last[0].timestamp_ns))
+            continue;
+        int i;
+        if (kept < n) {
+            i = kept++;
+        } else {
+            memmove(last, last + 1, sizeof(LogEntry) * (size_t)(n - 1));
+            i = n - 1;
+        }
+        while (i > 0 && last[i - 1].timestamp_ns > e.timestamp_ns) {
+            last[i] = last[i - 1];
+            i--;
+        }
+        last[i] = e;
+    }
+    fclose(f);
+
+    printf("  ── Last %d transactions ──\n", kept);
     printf("  %-8s %-8s %-12s %-10s %-12s %s\n",
            "Thread", "Account", "Type", "Amount", "New Bal", "Status");
     printf("  %s\n",
            "────────────────────────────────────────────────────────────");
-    for (int i = start; i < log_index; i++) {
+    for (int i = 0; i < kept; i++) {
         printf("  T%-7d A%-7d %-12s $%-9.2f $%-11.2f %s\n",
-               txn_log[i].thread_id,
-               txn_log[i].account_id,
-               txn_log[i].type,
-               txn_log[i].amount,
-               txn_log[i].new_balance,
-               txn_log[i].success ? "OK" : "INSUFFICIENT FUNDS");
+               last[i].thread_id,
+               last[i].account_id,
+               last[i].type == LOG_DEPOSIT ? "DEPOSIT" : "WITHDRAWAL",
+               last[i].amount,
+               last[i].new_balance,
+               last[i].success ? "OK" : "INSUFFICIENT FUNDS");
     }
-    printf("\n");
+    printf("  (%ld transactions in %s)\n\n", total, path);
+    free(last);
+    return 0;
 }
 
 /* ─── Main ──────────────────────────────────────────────────── */
-int main(void) {
+int main(int argc, char **argv) {
     int total_txns;
+    int num_threads = NUM_THREADS;
+    const char *prog     = argv[0];
+    const char *log_path = DEFAULT_LOG_FILE;
+
+    /* Viewer mode */
+    if (argc >= 3 && strcmp(argv[1], "--view") == 0) {
+        int n = (argc > 3) ? atoi(argv[3]) : 20;
+        if (argc > 4 || n < 0) {
+            fprintf(stderr, "Usage: %s --view FILE [N]\n", prog);
+            return EXIT_FAILURE;
+        }
+        return print_log(argv[2], n) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    base_seed = (uint64_t)time(NULL) ^ (uint64_t)getpid();
+    while (argc >= 3 && strncmp(argv[1], "--", 2) == 0) {
+        if (strcmp(argv[1], "--log") == 0)
+            log_path = argv[2];
+        else if (strcmp(argv[1], "--seed") == 0)
+            base_seed = strtoull(argv[2], NULL, 10);
+        else
+            break;
+        argc -= 2;
+        argv += 2;
+    }
+
+    if (argc > 3 || (argc > 1 && strncmp(argv[1], "--", 2) == 0)) {
+        fprintf(stderr, "Usage: %s [--log FILE] [--seed N] [num_threads [chunk_size]]\n"
+                        "       %s --view FILE [N]\n", prog, prog);
+        return EXIT_FAILURE;
+    }
+    if (argc > 1) {
+        num_threads = atoi(argv[1]);
+        if (num_threads <= 0 || num_threads > MAX_THREADS) {
+            fprintf(stderr, "  Invalid num_threads (must be 1..%d).\n",
+                    MAX_THREADS);
+            return EXIT_FAILURE;
+        }
+    }
+    if (argc > 2) {
+        claim_chunk = atoi(argv[2]);
+        if (claim_chunk <= 0) {
+            fprintf(stderr, "  Invalid chunk_size (must be positive).\n");
+            return EXIT_FAILURE;
+        }
+    }
 
     printf("\n");
     printf("  ┌─────────────────────────────────────────┐\n");
     printf("  │  Concurrent Bank Account Simulation     │\n");
     printf("  │  %d accounts · %d worker threads · pthreads │\n",
-           NUM_ACCOUNTS, NUM_THREADS);
+           NUM_ACCOUNTS, num_threads);
     printf("  └─────────────────────────────────────────┘\n\n");
     printf("  Each account starts with $%.2f.\n", INITIAL_BALANCE);
     printf("  Threads will randomly deposit or withdraw up to $%.2f.\n\n",
@@ -217,25 +470,45 @@ int main(void) {
         return EXIT_FAILURE;
     }
 
-    /* Cap log to avoid overflow */
-    if (total_txns > LOG_SIZE) {
-        printf("  (Transaction log capped at %d entries for display.)\n",
-               LOG_SIZE);
-    }
+    if (claim_chunk > total_txns) claim_chunk = total_txns;
 
     /* ── Setup ── */
     init_accounts();
     transactions_remaining = total_txns;
 
-    pthread_t threads[NUM_THREADS];
-    int       thread_ids[NUM_THREADS];
+    log_file = fopen(log_path, "wb");
+    if (!log_file) {
+        perror(log_path);
+        return EXIT_FAILURE;
+    }
+    fwrite(LOG_MAGIC, 1, 8, log_file);
+    log_ring_count = num_threads;
+    log_rings = (LogRing *)aligned_alloc(CACHE_LINE, sizeof(LogRing) * (size_t)num_threads);
+    if (!log_rings) {
+        perror("  aligned_alloc");
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < num_threads; i++) {
+        atomic_init(&log_rings[i].head, 0);
+        atomic_init(&log_rings[i].tail, 0);
+    }
+    atomic_init(&log_done, 0);
+
+    pthread_t threads[MAX_THREADS];
+    int       thread_ids[MAX_THREADS];
+    pthread_t writer;
+
+    if (pthread_create(&writer, NULL, log_writer, NULL) != 0) {
+        perror("  pthread_create");
+        return EXIT_FAILURE;
+    }
 
-    printf("\n  Starting %d threads...\n", NUM_THREADS);
+    printf("\n  Starting %d threads...\n", num_threads);
 
     struct timespec ts_start, ts_end;
     clock_gettime(CLOCK_MONOTONIC, &ts_start);
 
-    for (int i = 0; i < NUM_THREADS; i++) {
+    for (int i = 0; i < num_threads; i++) {
         thread_ids[i] = i + 1;
         if (pthread_create(&threads[i], NULL, worker, &thread_ids[i]) != 0) {
             perror("  pthread_create");
@@ -244,7 +517,7 @@ int main(void) {
     }
 
     /* ── Wait ── */
-    for (int i = 0; i < NUM_THREADS; i++) {
+    for (int i = 0; i < num_threads; i++) {
         pthread_join(threads[i], NULL);
     }
 
@@ -253,13 +526,21 @@ int main(void) {
                      (ts_end.tv_nsec - ts_start.tv_nsec) * 1e-9;
 
     printf("  All threads completed in %.4f seconds.\n", elapsed);
+    printf("  Throughput: %.0f transactions/sec (chunk %d).\n",
+           elapsed > 0 ? total_txns / elapsed : 0.0, claim_chunk);
+    printf("  Seed: %llu\n", (unsigned long long)base_seed);
+
+    /* ── Flush the log ── */
+    atomic_store_explicit(&log_done, 1, memory_order_release);
+    pthread_join(writer, NULL);
+    int log_ok = !ferror(log_file);
+    if (fclose(log_file) != 0) log_ok = 0;
+    free(log_rings);
+    if (!log_ok) fprintf(stderr, "  %s: write error\n", log_path);
 
     /* ── Show last 20 log entries (or all if fewer) ── */
-    int show = (log_index < 20) ? log_index : 20;
-    if (show > 0) {
-        printf("\n");
-        print_log(show);
-    }
+    printf("\n");
+    print_log(log_path, 20);
 
     /* ── Summary ── */
     print_summary(total_txns);
@@ -268,8 +549,6 @@ int main(void) {
     for (int i = 0; i < NUM_ACCOUNTS; i++) {
         pthread_mutex_destroy(&accounts[i].lock);
     }
-    pthread_mutex_destroy(&counter_lock);
-    pthread_mutex_destroy(&log_lock);
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
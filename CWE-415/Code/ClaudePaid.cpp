@@ -5,7 +5,16 @@
  * using POSIX threads (pthreads) with mutex-based synchronization.
  *
  * Compile: gcc -o bank_simulation bank_simulation.c -lpthread
- * Run:     ./bank_simulation
+ *          (add -DPACKED_ACCOUNTS for the unpadded account layout)
+ * Run:     ./bank_simulation [--quiet] [--seed N] [num_threads]
+ *
+ * --quiet drops the per-transaction lines (for timing runs).
+ * --seed N repeats a run's random transactions (exactly so with one
+ * thread; with more, the interleaving is up to the scheduler).
+ *
+ * Statistics are kept per worker thread and merged when the threads are
+ * joined; per-account counters are batched locally and flushed into the
+ * accounts every STATS_FLUSH_EVERY transactions.
  */
 
 #include <stdio.h>
@@ -13,18 +22,37 @@
 #include <pthread.h>
 #include <time.h>
 #include <string.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <unistd.h>
 
 /* ─── Constants ───────────────────────────────────────────────────── */
 #define NUM_ACCOUNTS     10
-#define NUM_THREADS      5          /* worker threads running in parallel  */
+#define NUM_THREADS      5          /* default worker threads               */
+#define MAX_THREADS      256
+#define STATS_FLUSH_EVERY 1024      /* transactions between per-account flushes */
 #define INITIAL_BALANCE  1000.00    /* every account starts at $1,000      */
 #define MAX_AMOUNT       200.00     /* maximum single transaction amount    */
 
+#define CACHE_LINE       64
+
+/* Account layout: the lock and balance (taken on every transaction) fill
+ * the first cache line of each account, the statistics the second, so no
+ * two accounts share a line and the hot fields never share one with the
+ * counters. -DPACKED_ACCOUNTS packs them back together for comparison. */
+#ifdef PACKED_ACCOUNTS
+#define LINE_ALIGNED
+#else
+#define LINE_ALIGNED     alignas(CACHE_LINE)
+#endif
+
 /* ─── Shared state ────────────────────────────────────────────────── */
 typedef struct {
+    /* hot */
+    LINE_ALIGNED pthread_mutex_t lock;
     double          balance;
-    pthread_mutex_t lock;
-    int             account_id;
+    /* cold */
+    LINE_ALIGNED int account_id;
     long            total_deposits;
     long            total_withdrawals;
     long            rejected_withdrawals;  /* insufficient funds */
@@ -36,25 +64,108 @@ static Account accounts[NUM_ACCOUNTS];
 static long         transactions_remaining;
 static pthread_mutex_t counter_lock = PTHREAD_MUTEX_INITIALIZER;
 
-/* Aggregate stats */
+/* Aggregate stats, summed from the workers after they are joined */
 static long total_completed   = 0;
 static long total_rejected    = 0;
-static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int quiet = 0;
 
 /* ─── Thread argument ─────────────────────────────────────────────── */
+/* Also the worker's private statistics. Each one starts on its own cache
+ * line, so neighbouring workers' counters never share one. */
 typedef struct {
-    int thread_id;
+    alignas(CACHE_LINE) int thread_id;
+    long completed;
+    long rejected;
+    /* Per-account counts not yet added to accounts[] */
+    long pending_deposits[NUM_ACCOUNTS];
+    long pending_withdrawals[NUM_ACCOUNTS];
+    long pending_rejected[NUM_ACCOUNTS];
+    int  since_flush;
 } ThreadArg;
 
-/* ─── Helper: thread-safe random double in [0, max] ──────────────── */
-static double rand_amount(unsigned int *seed) {
-    return ((double)rand_r(seed) / RAND_MAX) * MAX_AMOUNT;
+/* ─── Random numbers ─────────────────────────────────────────────── */
+/* xoshiro256**, one instance per thread */
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/* splitmix64 expansion of (seed, stream) into the 256-bit state */
+static void rng_seed(Rng *r, uint64_t seed, uint64_t stream) {
+    uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        r->s[i] = z ^ (z >> 31);
+    }
+}
+
+static inline uint64_t rng_next(Rng *r) {
+    uint64_t *s = r->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+/* Uniform integer in [0, n), n > 0 */
+static inline uint32_t rng_below(Rng *r, uint32_t n) {
+    uint64_t m = (rng_next(r) >> 32) * n;
+    if ((uint32_t)m < n) {
+        uint32_t threshold = -n % n;
+        while ((uint32_t)m < threshold) m = (rng_next(r) >> 32) * n;
+    }
+    return (uint32_t)(m >> 32);
+}
+
+/* Uniform double in [0, 1) */
+static inline double rng_double(Rng *r) {
+    return (double)(rng_next(r) >> 11) / 9007199254740992.0;   /* 2^53 */
+}
+
+static uint64_t base_seed;      /* --seed, or time ^ pid */
+
+/* ─── Helper: random amount in [0, MAX_AMOUNT) ───────────────────── */
+static double rand_amount(Rng *rng) {
+    return rng_double(rng) * MAX_AMOUNT;
+}
+
+/* ─── Per-account stats flush ─────────────────────────────────────── */
+/* Adds the worker's pending per-account counts to the accounts, under each
+ * account's lock, and clears them. */
+static void flush_account_stats(ThreadArg *targ) {
+    for (int i = 0; i < NUM_ACCOUNTS; i++) {
+        if (!targ->pending_deposits[i] && !targ->pending_withdrawals[i] &&
+            !targ->pending_rejected[i])
+            continue;
+        Account *acc = &accounts[i];
+        pthread_mutex_lock(&acc->lock);
+        acc->total_deposits       += targ->pending_deposits[i];
+        acc->total_withdrawals    += targ->pending_withdrawals[i];
+        acc->rejected_withdrawals += targ->pending_rejected[i];
+        pthread_mutex_unlock(&acc->lock);
+        targ->pending_deposits[i]    = 0;
+        targ->pending_withdrawals[i] = 0;
+        targ->pending_rejected[i]    = 0;
+    }
+    targ->since_flush = 0;
 }
 
 /* ─── Worker thread ───────────────────────────────────────────────── */
 static void *worker(void *arg) {
-    ThreadArg    *targ = (ThreadArg *)arg;
-    unsigned int  seed = (unsigned int)(time(NULL) ^ (targ->thread_id * 1000003UL));
+    ThreadArg *targ = (ThreadArg *)arg;
+    Rng        rng;
+    rng_seed(&rng, base_seed, (uint64_t)targ->thread_id);
 
     while (1) {
         /* Atomically claim one transaction slot */
@@ -67,46 +178,44 @@ static void *worker(void *arg) {
         pthread_mutex_unlock(&counter_lock);
 
         /* Pick a random account and amount */
-        int    acc_idx = rand_r(&seed) % NUM_ACCOUNTS;
-        double amount  = rand_amount(&seed);
-        int    is_deposit = rand_r(&seed) % 2;   /* 0 = withdraw, 1 = deposit */
+        int    acc_idx = (int)rng_below(&rng, NUM_ACCOUNTS);
+        double amount  = rand_amount(&rng);
+        int    is_deposit = (int)rng_below(&rng, 2);   /* 0 = withdraw, 1 = deposit */
 
         Account *acc = &accounts[acc_idx];
         pthread_mutex_lock(&acc->lock);
 
         if (is_deposit) {
             acc->balance += amount;
-            acc->total_deposits++;
-            printf("  [T%d] DEPOSIT   Account #%02d  +$%8.2f  =>  Balance: $%10.2f\n",
-                   targ->thread_id, acc->account_id, amount, acc->balance);
-
-            pthread_mutex_lock(&stats_lock);
-            total_completed++;
-            pthread_mutex_unlock(&stats_lock);
+            targ->pending_deposits[acc_idx]++;
+            if (!quiet)
+                printf("  [T%d] DEPOSIT   Account #%02d  +$%8.2f  =>  Balance: $%10.2f\n",
+                       targ->thread_id, acc->account_id, amount, acc->balance);
+            targ->completed++;
         } else {
             if (amount <= acc->balance) {
                 acc->balance -= amount;
-                acc->total_withdrawals++;
-                printf("  [T%d] WITHDRAW  Account #%02d  -$%8.2f  =>  Balance: $%10.2f\n",
-                       targ->thread_id, acc->account_id, amount, acc->balance);
-
-                pthread_mutex_lock(&stats_lock);
-                total_completed++;
-                pthread_mutex_unlock(&stats_lock);
+                targ->pending_withdrawals[acc_idx]++;
+                if (!quiet)
+                    printf("  [T%d] WITHDRAW  Account #%02d  -$%8.2f  =>  Balance: $%10.2f\n",
+                           targ->thread_id, acc->account_id, amount, acc->balance);
+                targ->completed++;
             } else {
-                acc->rejected_withdrawals++;
-                printf("  [T%d] REJECTED  Account #%02d  -$%8.2f  (insufficient funds, balance $%.2f)\n",
-                       targ->thread_id, acc->account_id, amount, acc->balance);
-
-                pthread_mutex_lock(&stats_lock);
-                total_rejected++;
-                pthread_mutex_unlock(&stats_lock);
+                targ->pending_rejected[acc_idx]++;
+                if (!quiet)
+                    printf("  [T%d] REJECTED  Account #%02d  -$%8.2f  (insufficient funds, balance $%.2f)\n",
+                           targ->thread_id, acc->account_id, amount, acc->balance);
+                targ->rejected++;
             }
         }
 
         pthread_mutex_unlock(&acc->lock);
+
+        if (++targ->since_flush >= STATS_FLUSH_EVERY)
+            flush_account_stats(targ);
     }
 
+    flush_account_stats(targ);
     return NULL;
 }
 
@@ -126,7 +235,6 @@ static void destroy_accounts(void) {
     for (int i = 0; i < NUM_ACCOUNTS; i++)
         pthread_mutex_destroy(&accounts[i].lock);
     pthread_mutex_destroy(&counter_lock);
-    pthread_mutex_destroy(&stats_lock);
 }
 
 static void print_summary(void) {
@@ -160,12 +268,38 @@ static void print_summary(void) {
 }
 
 /* ─── Main ────────────────────────────────────────────────────────── */
-int main(void) {
+int main(int argc, char **argv) {
     long num_transactions;
+    int  num_threads = NUM_THREADS;
+    int  argi = 1;
+
+    base_seed = (uint64_t)time(NULL) ^ (uint64_t)getpid();
+    while (argi < argc && strncmp(argv[argi], "--", 2) == 0) {
+        if (strcmp(argv[argi], "--quiet") == 0) {
+            quiet = 1;
+            argi++;
+        } else if (strcmp(argv[argi], "--seed") == 0 && argi + 1 < argc) {
+            base_seed = strtoull(argv[argi + 1], NULL, 10);
+            argi += 2;
+        } else {
+            break;
+        }
+    }
+    if (argi < argc && strncmp(argv[argi], "--", 2) != 0) {
+        num_threads = atoi(argv[argi++]);
+        if (num_threads <= 0 || num_threads > MAX_THREADS) {
+            fprintf(stderr, "num_threads must be 1..%d\n", MAX_THREADS);
+            return EXIT_FAILURE;
+        }
+    }
+    if (argi < argc) {
+        fprintf(stderr, "Usage: %s [--quiet] [--seed N] [num_threads]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
 
     printf("╔════════════════════════════════════════╗\n");
     printf("║   pthread Bank Account Simulator       ║\n");
-    printf("║   Accounts: %d  |  Threads: %d          ║\n", NUM_ACCOUNTS, NUM_THREADS);
+    printf("║   Accounts: %d  |  Threads: %d          ║\n", NUM_ACCOUNTS, num_threads);
     printf("╚════════════════════════════════════════╝\n\n");
 
     printf("Enter number of transaction simulations to run: ");
@@ -181,13 +315,16 @@ int main(void) {
     printf("\nInitial balance for all %d accounts: $%.2f each\n",
            NUM_ACCOUNTS, INITIAL_BALANCE);
     printf("Launching %d worker threads for %ld transactions...\n\n",
-           NUM_THREADS, num_transactions);
+           num_threads, num_transactions);
 
     /* Spawn threads */
-    pthread_t threads[NUM_THREADS];
-    ThreadArg args[NUM_THREADS];
+    static pthread_t threads[MAX_THREADS];
+    static ThreadArg args[MAX_THREADS];
+
+    struct timespec ts_start, ts_end;
+    clock_gettime(CLOCK_MONOTONIC, &ts_start);
 
-    for (int i = 0; i < NUM_THREADS; i++) {
+    for (int i = 0; i < num_threads; i++) {
         args[i].thread_id = i + 1;
         if (pthread_create(&threads[i], NULL, worker, &args[i]) != 0) {
             perror("pthread_create");
@@ -195,9 +332,19 @@ int main(void) {
         }
     }
 
-    /* Wait for all threads to finish */
-    for (int i = 0; i < NUM_THREADS; i++)
+    /* Wait for all threads to finish, then merge their counts */
+    for (int i = 0; i < num_threads; i++) {
         pthread_join(threads[i], NULL);
+        total_completed += args[i].completed;
+        total_rejected  += args[i].rejected;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts_end);
+    double elapsed = (ts_end.tv_sec  - ts_start.tv_sec) +
+                     (ts_end.tv_nsec - ts_start.tv_nsec) * 1e-9;
+    printf("\n%ld transactions in %.4f s (%.0f transactions/sec)\n",
+           num_transactions, elapsed, elapsed > 0 ? num_transactions / elapsed : 0.0);
+    printf("Seed: %llu\n", (unsigned long long)base_seed);
 
     print_summary();
     destroy_accounts();
@@ -4,6 +4,7 @@
 #include <unistd.h>
 #include <time.h>
 #include <string.h>
+#include <stdint.h>
 
 #define NUM_ACCOUNTS 10
 #define INITIAL_BALANCE 1000.0
@@ -13,6 +14,49 @@ typedef struct {
     pthread_mutex_t lock;
 } BankAccount;
 
+// Thread-local xoshiro256** generator (no shared state between workers).
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// splitmix64 expansion of (seed, stream) into the 256-bit state
+static void rng_seed(Rng *r, uint64_t seed, uint64_t stream) {
+    uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        r->s[i] = z ^ (z >> 31);
+    }
+}
+
+static inline uint64_t rng_next(Rng *r) {
+    uint64_t *s = r->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+// Uniform integer in [0, n), n > 0
+static inline uint32_t rng_below(Rng *r, uint32_t n) {
+    uint64_t m = (rng_next(r) >> 32) * n;
+    if ((uint32_t)m < n) {
+        uint32_t threshold = -n % n;
+        while ((uint32_t)m < threshold) m = (rng_next(r) >> 32) * n;
+    }
+    return (uint32_t)(m >> 32);
+}
+
 typedef struct {
     int account_id;
     int transaction_count;
@@ -21,6 +65,7 @@ typedef struct {
 
 BankAccount accounts[NUM_ACCOUNTS];
 int total_transactions = 0;
+uint64_t base_seed; // --seed, or time ^ pid
 
 /**
  * Perform a deposit on the specified account
@@ -77,16 +122,18 @@ int withdraw(int account_id, double amount) {
 void* transaction_thread(void *arg) {
     ThreadArgs *args = (ThreadArgs *)arg;
     int transactions_completed = 0;
+    Rng rng;
+    rng_seed(&rng, base_seed, (uint64_t)args->account_id);
     
     for (int i = 0; i < args->transaction_count; i++) {
         // Randomly select an account
-        int account_id = rand() % NUM_ACCOUNTS;
+        int account_id = (int)rng_below(&rng, NUM_ACCOUNTS);
         
         // Randomly generate transaction amount (0.01 to 100.00)
-        double amount = (rand() % 10000 + 1) / 100.0;
+        double amount = (rng_below(&rng, 10000) + 1) / 100.0;
         
         // Randomly choose deposit or withdrawal (50/50 chance)
-        if (rand() % 2 == 0) {
+        if (rng_below(&rng, 2) == 0) {
             deposit(account_id, amount);
         } else {
             withdraw(account_id, amount);
@@ -95,7 +142,7 @@ void* transaction_thread(void *arg) {
         transactions_completed++;
         
         // Small random delay to simulate real-world processing
-        usleep(rand() % 1000);
+        usleep(rng_below(&rng, 1000));
     }
     
     printf("[Thread %d completed %d transactions]\n", args->account_id, transactions_completed);
@@ -144,12 +191,23 @@ void cleanup_accounts(void) {
     }
 }
 
-int main(void) {
+/**
+ * Usage: ./bank [--seed N]
+ * --seed N repeats a run's random transactions (exactly so with one thread;
+ * with more, the interleaving is up to the scheduler).
+ */
+int main(int argc, char **argv) {
     int num_transactions;
     int num_threads;
     
-    // Seed the random number generator
-    srand((unsigned int)time(NULL));
+    // Seed the random number generators
+    base_seed = (uint64_t)time(NULL) ^ (uint64_t)getpid();
+    if (argc == 3 && strcmp(argv[1], "--seed") == 0) {
+        base_seed = strtoull(argv[2], NULL, 10);
+    } else if (argc != 1) {
+        fprintf(stderr, "Usage: %s [--seed N]\n", argv[0]);
+        return 1;
+    }
     
     printf("====== BANK ACCOUNT SIMULATOR ======\n");
     printf("Accounts: %d\n", NUM_ACCOUNTS);
@@ -183,7 +241,7 @@ int main(void) {
     int remaining_transactions = num_transactions % num_threads;
     
     for (int i = 0; i < num_threads; i++) {
-        ThreadArgs *args = malloc(sizeof(ThreadArgs));
+        ThreadArgs *args = (ThreadArgs *)malloc(sizeof(ThreadArgs));
         if (args == NULL) {
             fprintf(stderr, "Memory allocation failed\n");
             return 1;
@@ -209,6 +267,7 @@ int main(void) {
     }
     
     printf("\n====== SIMULATION COMPLETE ======\n");
+    printf("Seed: %llu\n", (unsigned long long)base_seed);
     
     // Print final balances
     print_account_balances();
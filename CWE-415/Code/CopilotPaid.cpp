@@ -1,117 +1,663 @@
 /*
   bank_pthreads.c
   --------------
-  Simulates deposits and withdrawals on 10 shared bank accounts using pthreads.
+  Simulates deposits and withdrawals (or transfers) on shared bank accounts
+  (10 by default) using pthreads.
 
   - Each account starts with an initial balance.
   - Multiple worker threads randomly choose an account and deposit/withdraw.
-  - Per-account mutexes protect balances (fine-grained locking).
+  - Mutex engine (default): a mutex per account guards its balance.
+  - Lock striping (--stripes S): S mutexes each guard a hashed set of
+    8-account ranges, 8 bytes per account instead of 48.
+  - Atomic engine (--engine atomic): balances are atomic int64_t; deposits
+    are a fetch-add, withdrawals a compare-and-swap loop that never takes a
+    balance below zero.
+  - Combining engine (--engine combining): a thread publishes its operation
+    on its lock's pending list; whichever thread holds the lock applies all
+    pending operations oldest first, rejecting overdrawing withdrawals.
+  - With --transfer, every transaction instead moves money between two
+    distinct accounts with both locks held: "ordered" always locks the
+    lower-numbered account first, so no cycle of waiters (deadlock) can
+    form; "trylock" locks the source, only tries the destination, and on
+    failure drops both and backs off for a random, doubling spin before
+    retrying, so it never blocks while holding a lock.
+  - Balances and locks live in anonymous mappings; tables of 2 MiB or more
+    are 2 MiB aligned and put on huge pages (MAP_HUGETLB if pages are
+    reserved, else transparent huge pages), so millions of accounts do
+    not cost a TLB miss per transaction. --pages small keeps 4 KiB pages.
   - User enters how many transaction simulations to run total.
+  - Threads claim transactions in chunks with an atomic fetch-and-add on a
+    shared index (no lock on the claim path).
+  - At the end, total money must equal the initial total plus everything
+    deposited minus everything withdrawn (conservation check); transfers
+    leave the total unchanged.
 
   Build:
-    gcc -O2 -Wall -Wextra -pthread bank_pthreads.c -o bank_pthreads
+    gcc -O2 -Wall -Wextra -pthread bank_pthreads.c -o bank_pthreads -lm
 
   Run:
-    ./bank_pthreads
+    ./bank_pthreads [--engine mutex|atomic|combining]
+                    [--pattern uniform|single|zipf] [--theta T]
+                    [--transfer ordered|trylock] [--accounts N] [--stripes S]
+                    [--pages small|huge] [--seed N] [num_threads [chunk_size]]
+
+    --pattern single sends every transaction to account 0 (worst-case
+    contention; for transfers, account 0 is one side of every transfer);
+    zipf picks account k with probability proportional to 1/(k+1)^T
+    (--theta, 0 < T < 1, default 0.99; for transfers, the source or destination);
+    uniform (the default) spreads them over all accounts.
+    --transfer needs the mutex engine and at least 2 accounts.
+    --seed N fixes a run's random transactions: each claimed chunk draws
+    from a generator seeded with (N, chunk index), whichever worker takes
+    it. With more than one thread the outcome still depends on the order
+    the chunks interleave in.
 */
 
+#include <fcntl.h>
+#include <math.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
 
-#define NUM_ACCOUNTS 10
+#include <sys/mman.h>
+
+// Builds as C11 or as C++: C++ takes the same atomic names from <atomic>.
+#ifdef __cplusplus
+#include <atomic>
+#define ATOMIC(T) std::atomic<T>
+using std::atomic_int;
+using std::atomic_long;
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::memory_order_seq_cst;
+#else
+#include <stdatomic.h>
+#define ATOMIC(T) _Atomic(T)
+#endif
+
+#define DEFAULT_ACCOUNTS 10
 #define DEFAULT_THREADS 4
+#define DEFAULT_CHUNK 1024
+#define MAX_PRINTED_ACCOUNTS 20   // larger runs print a summary instead
+#define BACKOFF_MAX 1024          // cap on the try-lock backoff, in spins
+#define CACHE_LINE 64
+#define HUGE_PAGE (2u << 20)
+#define STRIPE_RANGE_SHIFT 3      // 8 accounts (one line of balances) per range
+#define COMBINE_ROUNDS 4          // pending-list drains per combining lock hold
+#define COMBINE_SPINS 64          // waiter spins between sched_yield()s
+#define DEFAULT_THETA 0.99
+
+typedef enum { ENGINE_MUTEX, ENGINE_ATOMIC, ENGINE_COMBINING } Engine;
+typedef enum { PATTERN_UNIFORM, PATTERN_SINGLE, PATTERN_ZIPF } Pattern;
+typedef enum { TRANSFER_NONE, TRANSFER_ORDERED, TRANSFER_TRYLOCK } TransferMode;
+typedef enum { BACKING_SMALL, BACKING_THP, BACKING_HUGETLB } Backing;
+
+#if defined(__x86_64__) || defined(__i386__)
+#define cpu_relax() __builtin_ia32_pause()
+#else
+#define cpu_relax() atomic_signal_fence(memory_order_seq_cst)
+#endif
+
+// A published deposit or withdrawal (--engine combining). Each worker owns
+// one and has at most one outstanding; the combiner fills in `ok` and then
+// sets `done`, after which the owner may reuse it.
+typedef struct Request {
+    struct Request *next;
+    int acct;
+    int64_t amount;               // > 0 deposit, < 0 withdrawal
+    int ok;
+    atomic_int done;
+} Request;
+
+// Zipfian sampler (Gray et al., "Quickly Generating Billion-Record Synthetic
+// Databases"): O(n) setup, O(1) per draw; valid for 0 < theta < 1.
+typedef struct {
+    double theta, alpha, zetan, eta, half_pow_theta;
+    int n;
+} Zipf;
 
+// One anonymous mapping; see map_table().
 typedef struct {
-    long balance;
-    pthread_mutex_t lock;
-} Account;
+    void *base;
+    size_t bytes;                 // mapped length
+    Backing backing;
+} Table;
 
 typedef struct {
-    Account *accounts;
+    // Atomic in both engines; the mutex engine only does relaxed loads and
+    // stores under the lock, which compile to plain moves.
+    ATOMIC(int64_t) *balances;
+    // Used by the mutex engine only: one lock per account, packed (stride
+    // sizeof(pthread_mutex_t)), or num_locks stripes padded to a cache line.
+    char *locks;
+    size_t lock_stride;
+    int num_locks;
+    int striped;
+    // Combining engine: a pending stack per lock, pushed with a CAS and
+    // drained whole with an exchange by the lock holder.
+    ATOMIC(Request *) *pending;
     int num_accounts;
+    Engine engine;
+    Pattern pattern;
+    Zipf zipf;
+    TransferMode transfer;
 
     long total_transactions;      // total transactions to run across all threads
-    long next_txn_index;          // shared counter of how many have been claimed so far
-    pthread_mutex_t txn_lock;     // protects next_txn_index
+    atomic_long next_txn_index;   // shared counter of how many have been claimed so far
+    long claim_chunk;             // transactions claimed per fetch-and-add
 
-    unsigned int seed;            // base seed for generating per-thread seeds
+    uint64_t seed;                // base seed for the per-chunk generators
 } SharedState;
 
-static long rand_range(unsigned int *seed, long lo, long hi) {
-    // inclusive range [lo, hi]
-    if (hi <= lo) return lo;
-    long span = hi - lo + 1;
-    return lo + (long)(rand_r(seed) % (unsigned long)span);
+// Per-thread tallies, summed after the join for the conservation check.
+// The array is packed, so workers count into a copy on their own stack and
+// store it back once at exit; bumping these in place would share lines.
+typedef struct {
+    SharedState *st;
+    int index;                    // worker number, the generator's stream
+    int64_t deposited;
+    int64_t withdrawn;
+    int64_t moved;                // total amount transferred
+    long transfers;               // transfers applied
+    long rejected;                // withdrawals or transfers refused for funds
+    long retries;                 // failed try-lock attempts
+    long combined;                // published operations applied while combining
+    long batches;                 // pending-list drains while combining
+} WorkerArgs;
+
+// xoshiro256** per claimed chunk; rng_below() is Lemire's unbiased multiply-shift.
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
 }
 
-static void *worker_thread(void *arg) {
-    SharedState *st = (SharedState *)arg;
+// splitmix64 expansion of (seed, stream) into the 256-bit state
+static void rng_seed(Rng *r, uint64_t seed, uint64_t stream) {
+    uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        r->s[i] = z ^ (z >> 31);
+    }
+}
 
-    // Create a per-thread RNG seed (rand_r is thread-safe with its own seed)
-    unsigned int seed = st->seed ^ (unsigned int)(uintptr_t)pthread_self() ^ (unsigned int)time(NULL);
+static inline uint64_t rng_next(Rng *r) {
+    uint64_t *s = r->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
 
-    for (;;) {
-        // Claim the next transaction index
-        pthread_mutex_lock(&st->txn_lock);
-        long idx = st->next_txn_index;
-        if (idx >= st->total_transactions) {
-            pthread_mutex_unlock(&st->txn_lock);
-            break;
+// Uniform integer in [0, n), n > 0
+static inline uint32_t rng_below(Rng *r, uint32_t n) {
+    uint64_t m = (rng_next(r) >> 32) * n;
+    if ((uint32_t)m < n) {
+        uint32_t threshold = -n % n;
+        while ((uint32_t)m < threshold) m = (rng_next(r) >> 32) * n;
+    }
+    return (uint32_t)(m >> 32);
+}
+
+// Uniform double in [0, 1)
+static inline double rng_double(Rng *r) {
+    return (double)(rng_next(r) >> 11) / 9007199254740992.0;   // 2^53
+}
+
+static void zipf_init(Zipf *z, int n, double theta) {
+    double zeta2 = 1.0 + pow(0.5, theta);
+    z->n = n;
+    z->theta = theta;
+    z->zetan = 0.0;
+    for (int i = 1; i <= n; i++) z->zetan += 1.0 / pow((double)i, theta);
+    z->alpha = 1.0 / (1.0 - theta);
+    z->eta = (1.0 - pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / z->zetan);
+    z->half_pow_theta = pow(0.5, theta);
+}
+
+// Account in [0, n), account 0 the most popular.
+static int zipf_next(const Zipf *z, Rng *rng) {
+    double u = rng_double(rng);
+    double uz = u * z->zetan;
+    if (uz < 1.0) return 0;
+    if (uz < 1.0 + z->half_pow_theta) return 1;
+    int k = (int)(z->n * pow(z->eta * u - z->eta + 1.0, z->alpha));
+    return k < z->n ? k : z->n - 1;
+}
+
+static int pick_account(const SharedState *st, Rng *rng) {
+    if (st->pattern == PATTERN_SINGLE) return 0;
+    if (st->pattern == PATTERN_ZIPF) return zipf_next(&st->zipf, rng);
+    return (int)rng_below(rng, (uint32_t)st->num_accounts);
+}
+
+static int thp_disabled(void) {
+    char buf[128] = {0};
+    int fd = open("/sys/kernel/mm/transparent_hugepage/enabled", O_RDONLY);
+    if (fd < 0) return 1;
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    return n <= 0 || strstr(buf, "[never]") != NULL;
+}
+
+// Maps a zeroed table of at least `want` bytes. With huge pages requested
+// and a table of 2 MiB or more, tries MAP_HUGETLB (needs pages reserved in
+// /proc/sys/vm/nr_hugepages), then a 2 MiB-aligned region advised with
+// MADV_HUGEPAGE; otherwise (or if both fail) it stays on small pages.
+// Returns 0 on success.
+static int map_table(Table *t, size_t want, int huge) {
+    t->base = NULL;
+    t->backing = BACKING_SMALL;
+    if (huge && want >= HUGE_PAGE) {
+        t->bytes = (want + HUGE_PAGE - 1) & ~(size_t)(HUGE_PAGE - 1);
+        void *p = mmap(NULL, t->bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            t->base = p;
+            t->backing = BACKING_HUGETLB;
+            return 0;
+        }
+        // Over-map by one huge page and trim, so THP can back all of it.
+        p = mmap(NULL, t->bytes + HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p != MAP_FAILED) {
+            uintptr_t raw = (uintptr_t)p;
+            uintptr_t start = (raw + HUGE_PAGE - 1) & ~(uintptr_t)(HUGE_PAGE - 1);
+            if (start > raw) munmap(p, start - raw);
+            munmap((char *)start + t->bytes, HUGE_PAGE - (start - raw));
+            t->base = (void *)start;
+            if (!thp_disabled() && madvise(t->base, t->bytes, MADV_HUGEPAGE) == 0) t->backing = BACKING_THP;
+            return 0;
         }
-        st->next_txn_index++;
-        pthread_mutex_unlock(&st->txn_lock);
+    }
+    t->bytes = want;
+    void *p = mmap(NULL, t->bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return -1;
+    t->base = p;
+    return 0;
+}
+
+static const char *backing_name(Backing b) {
+    return b == BACKING_HUGETLB ? "hugetlb" : b == BACKING_THP ? "thp" : "small-pages";
+}
+
+// kB of the process on transparent huge pages, or -1 if unknown.
+static long anon_huge_kb(void) {
+    FILE *f = fopen("/proc/self/smaps_rollup", "r");
+    if (!f) return -1;
+    char line[256];
+    long kb = -1;
+    while (fgets(line, sizeof(line), f))
+        if (sscanf(line, "AnonHugePages: %ld kB", &kb) == 1) break;
+    fclose(f);
+    return kb;
+}
+
+// Striping hashes whole 8-account ranges, so accounts whose balances share
+// a cache line also share a lock.
+static inline int lock_index(const SharedState *st, int acct) {
+    if (!st->striped) return acct;
+    uint64_t range = (uint64_t)acct >> STRIPE_RANGE_SHIFT;
+    return (int)(((range * 0x9E3779B97F4A7C15ULL) >> 32) % (uint64_t)st->num_locks);
+}
+
+static inline pthread_mutex_t *lock_for(const SharedState *st, int acct) {
+    return (pthread_mutex_t *)(st->locks + (size_t)lock_index(st, acct) * st->lock_stride);
+}
+
+static void deposit(SharedState *st, int acct, int64_t amount) {
+    ATOMIC(int64_t) *a = &st->balances[acct];
+    if (st->engine == ENGINE_ATOMIC) {
+        atomic_fetch_add_explicit(a, amount, memory_order_relaxed);
+        return;
+    }
+    pthread_mutex_t *lock = lock_for(st, acct);
+    pthread_mutex_lock(lock);
+    int64_t b = atomic_load_explicit(a, memory_order_relaxed);
+    atomic_store_explicit(a, b + amount, memory_order_relaxed);
+    pthread_mutex_unlock(lock);
+}
+
+// Returns 1 if the withdrawal was applied, 0 if rejected for insufficient funds.
+static int withdraw(SharedState *st, int acct, int64_t amount) {
+    ATOMIC(int64_t) *a = &st->balances[acct];
+    if (st->engine == ENGINE_ATOMIC) {
+        int64_t b = atomic_load_explicit(a, memory_order_relaxed);
+        do {
+            if (b < amount) return 0;
+        } while (!atomic_compare_exchange_weak_explicit(a, &b, b - amount,
+                                                        memory_order_relaxed, memory_order_relaxed));
+        return 1;
+    }
+    int ok = 0;
+    pthread_mutex_t *lock = lock_for(st, acct);
+    pthread_mutex_lock(lock);
+    int64_t b = atomic_load_explicit(a, memory_order_relaxed);
+    if (b >= amount) {
+        atomic_store_explicit(a, b - amount, memory_order_relaxed);
+        ok = 1;
+    }
+    pthread_mutex_unlock(lock);
+    return ok;
+}
+
+// Moves amount between two accounts whose locks the caller holds.
+// Returns 1 if applied, 0 if the source has insufficient funds.
+static int move_locked(SharedState *st, int from, int to, int64_t amount) {
+    ATOMIC(int64_t) *src = &st->balances[from];
+    ATOMIC(int64_t) *dst = &st->balances[to];
+    int64_t b = atomic_load_explicit(src, memory_order_relaxed);
+    if (b < amount) return 0;
+    atomic_store_explicit(src, b - amount, memory_order_relaxed);
+    b = atomic_load_explicit(dst, memory_order_relaxed);
+    atomic_store_explicit(dst, b + amount, memory_order_relaxed);
+    return 1;
+}
+
+// Global lock order (lower lock index first): every thread waits for locks
+// in the same order, so none can hold a lock another holder is waiting on.
+// Both accounts may hash to one stripe; it is then taken once.
+static int transfer_ordered(SharedState *st, int from, int to, int64_t amount) {
+    int lf = lock_index(st, from), lt = lock_index(st, to);
+    pthread_mutex_t *first = lock_for(st, lf < lt ? from : to);
+    pthread_mutex_t *second = lf == lt ? NULL : lock_for(st, lf < lt ? to : from);
+    pthread_mutex_lock(first);
+    if (second) pthread_mutex_lock(second);
+    int ok = move_locked(st, from, to, amount);
+    if (second) pthread_mutex_unlock(second);
+    pthread_mutex_unlock(first);
+    return ok;
+}
+
+// Spins for a random count below *backoff, then doubles it up to
+// BACKOFF_MAX. Once capped, also yields: the lock holder may be waiting
+// for a CPU.
+static void backoff_wait(Rng *rng, unsigned *backoff) {
+    unsigned spins = 1 + rng_below(rng, *backoff);
+    for (unsigned i = 0; i < spins; i++) cpu_relax();
+    if (*backoff < BACKOFF_MAX) *backoff *= 2;
+    else sched_yield();
+}
+
+// Try-lock with backoff: blocks only on the source lock, with nothing
+// held, so lock order does not matter. *retries counts failed attempts.
+static int transfer_trylock(SharedState *st, Rng *rng, int from, int to, int64_t amount, long *retries) {
+    pthread_mutex_t *src = lock_for(st, from);
+    pthread_mutex_t *dst = lock_for(st, to);
+    if (src == dst) dst = NULL;
+    unsigned backoff = 1;
+    for (;;) {
+        pthread_mutex_lock(src);
+        if (!dst || pthread_mutex_trylock(dst) == 0) break;
+        pthread_mutex_unlock(src);
+        (*retries)++;
+        backoff_wait(rng, &backoff);
+    }
+    int ok = move_locked(st, from, to, amount);
+    if (dst) pthread_mutex_unlock(dst);
+    pthread_mutex_unlock(src);
+    return ok;
+}
+
+// Two distinct accounts; with --pattern single, account 0 is one of them.
+static void pick_pair(SharedState *st, Rng *rng, int *from, int *to) {
+    uint32_t n = (uint32_t)st->num_accounts;
+    int a = pick_account(st, rng);
+    int b = (int)((a + 1 + rng_below(rng, n - 1)) % n);
+    if (rng_below(rng, 2)) {
+        *from = a;
+        *to = b;
+    } else {
+        *from = b;
+        *to = a;
+    }
+}
+
+// Applies one deposit (amount > 0) or withdrawal (amount < 0) under the
+// account's lock. Returns 0 for a withdrawal that would overdraw.
+static int apply_locked(SharedState *st, int acct, int64_t amount) {
+    ATOMIC(int64_t) *a = &st->balances[acct];
+    int64_t b = atomic_load_explicit(a, memory_order_relaxed);
+    if (amount < 0 && b < -amount) return 0;
+    atomic_store_explicit(a, b + amount, memory_order_relaxed);
+    return 1;
+}
 
-        int acct = (int)rand_range(&seed, 0, st->num_accounts - 1);
+// Applies a drained pending stack under its lock. The stack is newest
+// first; reversing it applies operations in the order they were published,
+// so each withdrawal sees every earlier deposit and is rejected only if the
+// balance at its turn is short.
+static void apply_batch(SharedState *st, Request *batch, WorkerArgs *w) {
+    Request *fifo = NULL;
+    while (batch) {
+        Request *next = batch->next;
+        batch->next = fifo;
+        fifo = batch;
+        batch = next;
+    }
+    while (fifo) {
+        Request *r = fifo;
+        fifo = r->next;           // read before `done`: the owner may reuse r
+        r->ok = apply_locked(st, r->acct, r->amount);
+        atomic_store_explicit(&r->done, 1, memory_order_release);
+        w->combined++;
+    }
+    w->batches++;
+}
 
-        // Choose deposit vs withdrawal
-        int do_deposit = (rand_r(&seed) & 1);
+// Lock holder: applies what other threads published meanwhile.
+static void drain_pending(SharedState *st, ATOMIC(Request *) *head, WorkerArgs *w) {
+    for (int round = 0; round < COMBINE_ROUNDS; round++) {
+        if (!atomic_load_explicit(head, memory_order_relaxed)) break;
+        apply_batch(st, atomic_exchange_explicit(head, NULL, memory_order_acquire), w);
+    }
+}
 
-        // Choose an amount (tweak as desired)
-        long amount = rand_range(&seed, 1, 200);
+// Flat combining. If the lock is free, apply our operation directly (no
+// publication) and then serve anyone waiting. Otherwise publish the request
+// and either see it applied by the current holder or take the lock and
+// apply everything pending. A request pushed before we hold the lock is
+// applied by the time we release it: either it is still on the stack, or
+// an earlier holder took it and finished before unlocking.
+// Returns the operation's result.
+static int combine(SharedState *st, Request *req, int acct, int64_t amount, WorkerArgs *w) {
+    ATOMIC(Request *) *head = &st->pending[lock_index(st, acct)];
+    pthread_mutex_t *lock = lock_for(st, acct);
+    if (pthread_mutex_trylock(lock) == 0) {
+        int ok = apply_locked(st, acct, amount);
+        drain_pending(st, head, w);
+        pthread_mutex_unlock(lock);
+        return ok;
+    }
 
-        if (do_deposit) {
-            pthread_mutex_lock(&st->accounts[acct].lock);
-            st->accounts[acct].balance += amount;
-            pthread_mutex_unlock(&st->accounts[acct].lock);
+    req->acct = acct;
+    req->amount = amount;
+    atomic_store_explicit(&req->done, 0, memory_order_relaxed);
+    Request *top = atomic_load_explicit(head, memory_order_relaxed);
+    do {
+        req->next = top;
+    } while (!atomic_compare_exchange_weak_explicit(head, &top, req, memory_order_release, memory_order_relaxed));
+
+    for (unsigned spins = 0;; spins++) {
+        if (atomic_load_explicit(&req->done, memory_order_acquire)) return req->ok;
+        if (pthread_mutex_trylock(lock) == 0) {
+            drain_pending(st, head, w);
+            pthread_mutex_unlock(lock);
+            return req->ok;
+        }
+        // On few CPUs the combiner may be waiting for ours.
+        if (spins < COMBINE_SPINS) {
+            cpu_relax();
         } else {
-            pthread_mutex_lock(&st->accounts[acct].lock);
-            if (st->accounts[acct].balance >= amount) {
-                st->accounts[acct].balance -= amount;
-            }
-            // else: insufficient funds -> transaction rejected (no change)
-            pthread_mutex_unlock(&st->accounts[acct].lock);
+            sched_yield();
+            spins = 0;
         }
+    }
+}
+
+static void *worker_thread(void *arg) {
+    WorkerArgs *out = (WorkerArgs *)arg;
+    WorkerArgs tally = *out;
+    WorkerArgs *w = &tally;
+    SharedState *st = w->st;
+
+    // rng is reseeded per chunk, so the transactions follow from the seed
+    // alone; trylock backoff draws from jitter so retries cannot shift them.
+    Rng rng, jitter;
+    rng_seed(&jitter, ~st->seed, (uint64_t)w->index);
+    Request req;
+
+    for (;;) {
+        // Claim the next chunk of transaction indices [idx, end)
+        long idx = atomic_fetch_add_explicit(&st->next_txn_index, st->claim_chunk, memory_order_relaxed);
+        if (idx >= st->total_transactions) break;
+        long left = st->total_transactions - idx;
+        long end = idx + (st->claim_chunk < left ? st->claim_chunk : left);
+        rng_seed(&rng, st->seed, (uint64_t)(idx / st->claim_chunk));
+
+        for (; idx < end; idx++) {
+            if (st->transfer != TRANSFER_NONE) {
+                int from, to;
+                pick_pair(st, &rng, &from, &to);
+                long amount = 1 + (long)rng_below(&rng, 200);
+                int ok = st->transfer == TRANSFER_ORDERED
+                             ? transfer_ordered(st, from, to, amount)
+                             : transfer_trylock(st, &jitter, from, to, amount, &w->retries);
+                if (ok) {
+                    w->transfers++;
+                    w->moved += amount;
+                } else {
+                    w->rejected++;
+                }
+                continue;
+            }
+
+            int acct = pick_account(st, &rng);
+
+            // Choose deposit vs withdrawal
+            int do_deposit = (int)rng_below(&rng, 2);
+
+            // Choose an amount (tweak as desired)
+            long amount = 1 + (long)rng_below(&rng, 200);
+
+            int ok;
+            if (st->engine == ENGINE_COMBINING) {
+                ok = combine(st, &req, acct, do_deposit ? amount : -amount, w);
+            } else if (do_deposit) {
+                deposit(st, acct, amount);
+                ok = 1;
+            } else {
+                ok = withdraw(st, acct, amount);
+            }
+
+            if (do_deposit) {
+                w->deposited += amount;
+            } else if (ok) {
+                w->withdrawn += amount;
+            } else {
+                // insufficient funds -> transaction rejected (no change)
+                w->rejected++;
+            }
 
-        // Optional: slow down to make interleavings easier to observe (comment out if undesired)
-        // usleep(1000);
+            // Optional: slow down to make interleavings easier to observe (comment out if undesired)
+            // usleep(1000);
+        }
     }
 
+    *out = tally;
     return NULL;
 }
 
 static void usage(const char *prog) {
-    fprintf(stderr, "Usage: %s [num_threads]\n", prog);
+    fprintf(stderr, "Usage: %s [--engine mutex|atomic|combining] [--pattern uniform|single|zipf] [--theta T]\n"
+                    "          [--transfer ordered|trylock] [--accounts N] [--stripes S]\n"
+                    "          [--pages small|huge] [--seed N] [num_threads [chunk_size]]\n", prog);
+    fprintf(stderr, "  engine default: mutex (per-account pthread mutexes)\n");
+    fprintf(stderr, "  pattern default: uniform (single = every transaction on account 0)\n");
+    fprintf(stderr, "  theta default: %.2f (zipf skew, 0 < theta < 1)\n", DEFAULT_THETA);
+    fprintf(stderr, "  transfer default: off (deposits and withdrawals)\n");
+    fprintf(stderr, "  accounts default: %d\n", DEFAULT_ACCOUNTS);
+    fprintf(stderr, "  stripes default: 0 (one lock per account)\n");
+    fprintf(stderr, "  pages default: huge (for tables of 2 MiB or more)\n");
+    fprintf(stderr, "  seed default: time ^ pid (printed at startup)\n");
     fprintf(stderr, "  num_threads default: %d\n", DEFAULT_THREADS);
+    fprintf(stderr, "  chunk_size default: %d (transactions claimed at a time)\n", DEFAULT_CHUNK);
 }
 
 int main(int argc, char **argv) {
     int num_threads = DEFAULT_THREADS;
+    long claim_chunk = DEFAULT_CHUNK;
+    Engine engine = ENGINE_MUTEX;
+    Pattern pattern = PATTERN_UNIFORM;
+    TransferMode transfer = TRANSFER_NONE;
+    int num_accounts = DEFAULT_ACCOUNTS;
+    int stripes = 0;
+    int huge_pages = 1;
+    double theta = DEFAULT_THETA;
+    uint64_t seed = (uint64_t)time(NULL) ^ (uint64_t)getpid();
+
+    // Options first, then the positional arguments.
+    const char *prog = argv[0];
+    int argi = 1;
+    for (; argi + 1 < argc && strncmp(argv[argi], "--", 2) == 0; argi += 2) {
+        const char *val = argv[argi + 1];
+        if (strcmp(argv[argi], "--engine") == 0 && strcmp(val, "mutex") == 0) engine = ENGINE_MUTEX;
+        else if (strcmp(argv[argi], "--engine") == 0 && strcmp(val, "atomic") == 0) engine = ENGINE_ATOMIC;
+        else if (strcmp(argv[argi], "--engine") == 0 && strcmp(val, "combining") == 0) engine = ENGINE_COMBINING;
+        else if (strcmp(argv[argi], "--pattern") == 0 && strcmp(val, "uniform") == 0) pattern = PATTERN_UNIFORM;
+        else if (strcmp(argv[argi], "--pattern") == 0 && strcmp(val, "single") == 0) pattern = PATTERN_SINGLE;
+        else if (strcmp(argv[argi], "--pattern") == 0 && strcmp(val, "zipf") == 0) pattern = PATTERN_ZIPF;
+        else if (strcmp(argv[argi], "--theta") == 0 && atof(val) > 0 && atof(val) < 1.0) theta = atof(val);
+        else if (strcmp(argv[argi], "--transfer") == 0 && strcmp(val, "ordered") == 0) transfer = TRANSFER_ORDERED;
+        else if (strcmp(argv[argi], "--transfer") == 0 && strcmp(val, "trylock") == 0) transfer = TRANSFER_TRYLOCK;
+        else if (strcmp(argv[argi], "--accounts") == 0 && atoi(val) > 0) num_accounts = atoi(val);
+        else if (strcmp(argv[argi], "--stripes") == 0 && atoi(val) > 0) stripes = atoi(val);
+        else if (strcmp(argv[argi], "--pages") == 0 && strcmp(val, "small") == 0) huge_pages = 0;
+        else if (strcmp(argv[argi], "--pages") == 0 && strcmp(val, "huge") == 0) huge_pages = 1;
+        else if (strcmp(argv[argi], "--seed") == 0) seed = strtoull(val, NULL, 10);
+        else {
+            usage(prog);
+            return 2;
+        }
+    }
+    argc -= argi - 1;
+    argv += argi - 1;
 
-    if (argc > 2) {
-        usage(argv[0]);
+    if (argc > 3 || (argc >= 2 && strncmp(argv[1], "--", 2) == 0)) {
+        usage(prog);
         return 2;
     }
-    if (argc == 2) {
+    if (transfer != TRANSFER_NONE && (engine != ENGINE_MUTEX || num_accounts < 2)) {
+        fprintf(stderr, "--transfer needs --engine mutex and at least 2 accounts\n");
+        return 2;
+    }
+    if (argc >= 2) {
         num_threads = atoi(argv[1]);
         if (num_threads <= 0 || num_threads > 256) {
             fprintf(stderr, "Invalid num_threads: %d (must be 1..256)\n", num_threads);
             return 2;
         }
     }
+    if (argc == 3) {
+        claim_chunk = atol(argv[2]);
+        if (claim_chunk <= 0) {
+            fprintf(stderr, "Invalid chunk_size: %ld (must be positive)\n", claim_chunk);
+            return 2;
+        }
+    }
 
     long total_transactions = 0;
     printf("Enter how many transaction simulations to run: ");
@@ -120,42 +666,89 @@ int main(int argc, char **argv) {
         fprintf(stderr, "Invalid input.\n");
         return 1;
     }
+    // A chunk larger than the run would only push the shared index further
+    // past the end (and, near LONG_MAX, wrap it).
+    if (claim_chunk > total_transactions) claim_chunk = total_transactions > 0 ? total_transactions : 1;
 
-    Account accounts[NUM_ACCOUNTS];
-    const long initial_balance = 1000;
+    SharedState st;
+    st.striped = stripes > 0;
+    st.num_locks = st.striped ? stripes : num_accounts;
+    st.lock_stride = st.striped ? (sizeof(pthread_mutex_t) + CACHE_LINE - 1) & ~(size_t)(CACHE_LINE - 1)
+                                : sizeof(pthread_mutex_t);
+    size_t balance_bytes = (size_t)num_accounts * sizeof(*st.balances);
+    size_t lock_bytes = (size_t)st.num_locks * st.lock_stride;
+    Table balance_table, lock_table;
+    if (map_table(&balance_table, balance_bytes, huge_pages) != 0 || map_table(&lock_table, lock_bytes, huge_pages) != 0) {
+        perror("mmap");
+        return 1;
+    }
+    st.balances = (ATOMIC(int64_t) *)balance_table.base;
+    st.locks = (char *)lock_table.base;
+    Table pending_table = {NULL, 0, BACKING_SMALL};
+    size_t pending_bytes = 0;
+    st.pending = NULL;
+    if (engine == ENGINE_COMBINING) {
+        // Zero-filled, so every stack starts empty.
+        pending_bytes = (size_t)st.num_locks * sizeof(*st.pending);
+        if (map_table(&pending_table, pending_bytes, huge_pages) != 0) {
+            perror("mmap");
+            return 1;
+        }
+        st.pending = (ATOMIC(Request *) *)pending_table.base;
+    }
 
-    for (int i = 0; i < NUM_ACCOUNTS; i++) {
-        accounts[i].balance = initial_balance;
-        if (pthread_mutex_init(&accounts[i].lock, NULL) != 0) {
-            fprintf(stderr, "pthread_mutex_init failed for account %d\n", i);
+    const long initial_balance = 1000;
+    for (int i = 0; i < num_accounts; i++) atomic_init(&st.balances[i], initial_balance);
+    for (int i = 0; i < st.num_locks; i++) {
+        if (pthread_mutex_init((pthread_mutex_t *)(st.locks + (size_t)i * st.lock_stride), NULL) != 0) {
+            fprintf(stderr, "pthread_mutex_init failed for lock %d\n", i);
             return 1;
         }
     }
 
-    SharedState st;
-    st.accounts = accounts;
-    st.num_accounts = NUM_ACCOUNTS;
+    st.num_accounts = num_accounts;
+    st.engine = engine;
+    st.pattern = pattern;
+    if (pattern == PATTERN_ZIPF) zipf_init(&st.zipf, num_accounts, theta);
+    st.transfer = transfer;
     st.total_transactions = total_transactions;
-    st.next_txn_index = 0;
-    st.seed = (unsigned int)time(NULL) ^ (unsigned int)getpid();
-    if (pthread_mutex_init(&st.txn_lock, NULL) != 0) {
-        fprintf(stderr, "pthread_mutex_init failed for txn_lock\n");
-        return 1;
-    }
+    atomic_init(&st.next_txn_index, 0);
+    st.claim_chunk = claim_chunk;
+    st.seed = seed;
 
     pthread_t *threads = (pthread_t *)calloc((size_t)num_threads, sizeof(pthread_t));
-    if (!threads) {
+    WorkerArgs *args = (WorkerArgs *)calloc((size_t)num_threads, sizeof(WorkerArgs));
+    if (!threads || !args) {
         perror("calloc");
         return 1;
     }
 
-    long initial_total = initial_balance * NUM_ACCOUNTS;
+    long initial_total = initial_balance * num_accounts;
     printf("\nStarting simulation:\n");
-    printf("  Accounts: %d\n  Initial balance each: %ld\n  Total initial: %ld\n  Threads: %d\n  Transactions: %ld\n\n",
-           NUM_ACCOUNTS, initial_balance, initial_total, num_threads, total_transactions);
+    printf("  Accounts: %d\n  Initial balance each: %ld\n  Total initial: %ld\n  Threads: %d\n  Transactions: %ld\n",
+           num_accounts, initial_balance, initial_total, num_threads, total_transactions);
+    printf("  Claim chunk: %ld\n", claim_chunk);
+    if (st.striped) printf("  Locks: %d stripes over %d-account ranges\n", stripes, 1 << STRIPE_RANGE_SHIFT);
+    else printf("  Locks: one per account\n");
+    printf("  Memory: %.1f bytes/account (balances %zu + locks %zu",
+           (double)(balance_bytes + lock_bytes + pending_bytes) / num_accounts, balance_bytes, lock_bytes);
+    if (pending_table.base) printf(" + pending lists %zu", pending_bytes);
+    printf(" bytes)\n");
+    printf("  Pages: balances %s, locks %s, %ld kB of the process on THP\n", backing_name(balance_table.backing),
+           backing_name(lock_table.backing), anon_huge_kb());
+    printf("  Engine: %s\n", engine == ENGINE_ATOMIC ? "atomic" : engine == ENGINE_COMBINING ? "combining" : "mutex");
+    if (pattern == PATTERN_ZIPF) printf("  Pattern: zipf (theta %.2f)\n", theta);
+    else printf("  Pattern: %s\n", pattern == PATTERN_SINGLE ? "single" : "uniform");
+    printf("  Transfer: %s\n", transfer == TRANSFER_ORDERED ? "ordered" : transfer == TRANSFER_TRYLOCK ? "trylock" : "off");
+    printf("  Seed: %llu\n\n", (unsigned long long)seed);
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
 
     for (int i = 0; i < num_threads; i++) {
-        if (pthread_create(&threads[i], NULL, worker_thread, &st) != 0) {
+        args[i].st = &st;
+        args[i].index = i;
+        if (pthread_create(&threads[i], NULL, worker_thread, &args[i]) != 0) {
             fprintf(stderr, "pthread_create failed (thread %d)\n", i);
             return 1;
         }
@@ -164,28 +757,67 @@ int main(int argc, char **argv) {
     for (int i = 0; i < num_threads; i++) {
         pthread_join(threads[i], NULL);
     }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double elapsed = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    int64_t deposited = 0, withdrawn = 0, moved = 0;
+    long rejected = 0, transfers = 0, retries = 0, combined = 0, batches = 0;
+    for (int i = 0; i < num_threads; i++) {
+        deposited += args[i].deposited;
+        withdrawn += args[i].withdrawn;
+        moved += args[i].moved;
+        transfers += args[i].transfers;
+        rejected += args[i].rejected;
+        retries += args[i].retries;
+        combined += args[i].combined;
+        batches += args[i].batches;
+    }
 
     long final_total = 0;
-    printf("Final account balances:\n");
-    for (int i = 0; i < NUM_ACCOUNTS; i++) {
+    int negative = 0;
+    int print_balances = num_accounts <= MAX_PRINTED_ACCOUNTS;
+    if (print_balances) printf("Final account balances:\n");
+    else printf("Final account balances: (%d accounts, not listed)\n", num_accounts);
+    for (int i = 0; i < num_accounts; i++) {
         // Lock to read consistently (not strictly needed after joins, but fine practice)
-        pthread_mutex_lock(&accounts[i].lock);
-        long b = accounts[i].balance;
-        pthread_mutex_unlock(&accounts[i].lock);
+        pthread_mutex_t *lock = lock_for(&st, i);
+        pthread_mutex_lock(lock);
+        long b = (long)atomic_load(&st.balances[i]);
+        pthread_mutex_unlock(lock);
 
-        printf("  Account %2d: %ld\n", i, b);
+        if (print_balances) printf("  Account %2d: %ld\n", i, b);
         final_total += b;
+        if (b < 0) negative = 1;
     }
 
     printf("\nTotals:\n");
     printf("  Total initial: %ld\n", initial_total);
     printf("  Total final:   %ld\n", final_total);
-    printf("  Note: total can change because deposits add money; withdrawals remove money.\n");
-    printf("        (Withdrawals are rejected if insufficient funds.)\n");
-
-    for (int i = 0; i < NUM_ACCOUNTS; i++) pthread_mutex_destroy(&accounts[i].lock);
-    pthread_mutex_destroy(&st.txn_lock);
+    if (transfer != TRANSFER_NONE) {
+        printf("  Transfers: %ld  Moved: %lld  Rejected transfers: %ld  Try-lock retries: %ld\n",
+               transfers, (long long)moved, rejected, retries);
+    } else {
+        printf("  Note: total can change because deposits add money; withdrawals remove money.\n");
+        printf("        (Withdrawals are rejected if insufficient funds.)\n");
+        printf("  Deposited: %lld  Withdrawn: %lld  Rejected withdrawals: %ld\n",
+               (long long)deposited, (long long)withdrawn, rejected);
+    }
+    if (engine == ENGINE_COMBINING)
+        printf("  Combining: %ld published operations applied in %ld batches (%.2f per batch)\n", combined, batches,
+               batches ? (double)combined / batches : 0.0);
+
+    long expected_total = initial_total + (long)deposited - (long)withdrawn;
+    int conserved = final_total == expected_total && !negative;
+    printf("  Conservation: %s (initial + deposited - withdrawn = %ld)\n",
+           conserved ? "OK" : "FAILED", expected_total);
+    printf("\nElapsed: %.4f s (%.0f transactions/sec)\n", elapsed, elapsed > 0 ? (double)total_transactions / elapsed : 0.0);
+
+    for (int i = 0; i < st.num_locks; i++) pthread_mutex_destroy((pthread_mutex_t *)(st.locks + (size_t)i * st.lock_stride));
+    munmap(balance_table.base, balance_table.bytes);
+    munmap(lock_table.base, lock_table.bytes);
+    if (pending_table.base) munmap(pending_table.base, pending_table.bytes);
     free(threads);
+    free(args);
 
-    return 0;
+    return conserved ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,136 @@
+/*
+ * PerfStat.c
+ *
+ * Runs one of the bank simulations (or any command) and reports its wall
+ * time and hardware counters, read with perf_event_open(2) across all of
+ * the child's threads:
+ *
+ *   cycles, instructions, cache-references, cache-misses, L1d-load-misses
+ *
+ * User space only (exclude_kernel), so it works at perf_event_paranoid <= 2.
+ * Counters that cannot be opened (no PMU in a VM, seccomp) print "n/a".
+ * The child inherits stdin, so the transaction count can be piped in:
+ *
+ *   echo 1000000 | ./PerfStat ./bank_simulation 8
+ *
+ * The report goes to stderr; --quiet sends the child's stdout to /dev/null.
+ *
+ * Build: gcc -std=gnu11 -O2 -Wall -o PerfStat PerfStat.c
+ * Run:   ./PerfStat [--quiet] COMMAND [ARGS...]
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+typedef struct {
+    const char *name;
+    uint32_t    type;
+    uint64_t    config;
+    int         fd;
+} Counter;
+
+#define CACHE_EVENT(cache, result) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | ((result) << 16))
+
+static Counter counters[] = {
+    {"cycles",          PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,       -1},
+    {"instructions",    PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,     -1},
+    {"cache-references", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES, -1},
+    {"cache-misses",    PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,     -1},
+    {"L1d-load-misses", PERF_TYPE_HW_CACHE,
+     CACHE_EVENT(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS), -1},
+};
+#define NUM_COUNTERS (int)(sizeof(counters) / sizeof(counters[0]))
+
+/* Counts the child and every thread it creates, starting at its exec(). */
+static int open_counter(Counter *c, pid_t pid) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = c->type;
+    attr.config         = c->config;
+    attr.disabled       = 1;
+    attr.enable_on_exec = 1;
+    attr.inherit        = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, pid, -1, -1, 0);
+}
+
+int main(int argc, char **argv) {
+    int first = 1;
+    int quiet = 0;
+    if (argc > 1 && strcmp(argv[1], "--quiet") == 0) {
+        quiet = 1;
+        first = 2;
+    }
+    if (first >= argc) {
+        fprintf(stderr, "Usage: %s [--quiet] COMMAND [ARGS...]\n", argv[0]);
+        return 2;
+    }
+
+    /* The child waits on the pipe until the counters are attached. */
+    int go[2];
+    if (pipe(go) != 0) {
+        perror("pipe");
+        return 1;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return 1;
+    }
+    if (pid == 0) {
+        char c;
+        close(go[1]);
+        if (read(go[0], &c, 1) < 0) _exit(127);
+        close(go[0]);
+        if (quiet) {
+            int devnull = open("/dev/null", O_WRONLY);
+            if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+        }
+        execvp(argv[first], argv + first);
+        fprintf(stderr, "%s: %s\n", argv[first], strerror(errno));
+        _exit(127);
+    }
+    close(go[0]);
+
+    for (int i = 0; i < NUM_COUNTERS; i++) counters[i].fd = open_counter(&counters[i], pid);
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (write(go[1], "x", 1) != 1) perror("write");
+    close(go[1]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double elapsed = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    fprintf(stderr, "\n  %-18s %14.4f s\n", "elapsed", elapsed);
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        uint64_t value = 0;
+        if (counters[i].fd < 0 ||
+            read(counters[i].fd, &value, sizeof(value)) != (ssize_t)sizeof(value)) {
+            fprintf(stderr, "  %-18s %14s\n", counters[i].name, "n/a");
+        } else {
+            fprintf(stderr, "  %-18s %14llu\n", counters[i].name, (unsigned long long)value);
+        }
+        if (counters[i].fd >= 0) close(counters[i].fd);
+    }
+
+    if (WIFEXITED(status)) return WEXITSTATUS(status);
+    fprintf(stderr, "  child killed by signal %d\n", WTERMSIG(status));
+    return 1;
+}
@@ -0,0 +1,161 @@
+/*
+ * CompactBench.cpp
+ *
+ * Traversal cost of ClaudePaid's list before and after compact().
+ *
+ *   1. The heap is churned first: N node-sized chunks are allocated and freed
+ *      in random order, so the list built next gets the scattered addresses a
+ *      long-lived list ends up with after many insert/delete/move operations.
+ *   2. An N-node list (1M by default) is built, its fragmentation() reported
+ *      and a full traversal plus a few positional deletes/inserts timed.
+ *   3. compact() relays it into one block; the same measurements are repeated.
+ *   4. A random op run on a smaller list is timed with auto-compaction off
+ *      and on, and must end with the same checksum either way.
+ *
+ * Build: g++ -std=c++17 -O2 -o CompactBench CompactBench.cpp
+ * Run:   ./CompactBench [--nodes N] [--seed S] [--churn-nodes N] [--churn-ops N]
+ */
+
+#include "ListAdapters.h"
+
+using claude_paid::SinglyLinkedList;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Leaves n node-sized chunks on the allocator's free lists in random order.
+static void churnHeap(std::mt19937& rng, int n) {
+    claude_paid::Node** chunks = new claude_paid::Node*[n];
+    for (int i = 0; i < n; ++i) chunks[i] = new claude_paid::Node(0);
+    for (int i = n - 1; i > 0; --i) {
+        int j = static_cast<int>(rng() % (i + 1));
+        claude_paid::Node* t = chunks[i];
+        chunks[i] = chunks[j];
+        chunks[j] = t;
+    }
+    for (int i = 0; i < n; ++i) delete chunks[i];
+    delete[] chunks;
+}
+
+struct Measured {
+    double traverseSecs;
+    double positionalSecs;
+};
+
+// Best of three full traversals, then a handful of deletes/inserts at random
+// positions (each walks on average half the list).
+static Measured measure(SinglyLinkedList& list, std::mt19937& rng) {
+    Measured m = {1e9, 0};
+    unsigned long long sink = 0;
+    for (int r = 0; r < 3; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        sink ^= listChecksum(list);
+        double t = secondsSince(start);
+        if (t < m.traverseSecs) m.traverseSecs = t;
+    }
+    const int kPositional = 20;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kPositional; ++i) {
+        int pos = static_cast<int>(rng() % list.getSize());
+        list.deleteAt(pos);
+        list.insertAt(pos, static_cast<int>(rng() % 1000));
+    }
+    m.positionalSecs = secondsSince(start) / (2 * kPositional);
+    if (sink == 1) std::printf(" "); // keeps the traversals from being optimized out
+    return m;
+}
+
+// Random insert/delete/move on a list of about n nodes; returns elapsed.
+static double churnList(SinglyLinkedList& list, unsigned int seed, int n, int ops) {
+    std::mt19937 rng(seed);
+    for (int i = 0; i < n; ++i) list.insertAt(0, static_cast<int>(rng() % 1000));
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ops; ++i) {
+        int size = list.getSize();
+        unsigned int kind = rng() % 3;
+        int a = static_cast<int>(rng() % (size + 1));
+        int b = static_cast<int>(rng() % (size + 1));
+        int value = static_cast<int>(rng() % 1000);
+        switch (kind) {
+            case 0: // insert then delete: size + 1 nodes in between
+                list.insertAt(a, value);
+                list.deleteAt(b);
+                break;
+            case 1: // delete then insert: size - 1 nodes in between
+                list.deleteAt(a % size);
+                list.insertAt(b % size, value);
+                break;
+            default:
+                list.moveNode(a % size, b);
+                break;
+        }
+    }
+    return secondsSince(start);
+}
+
+int main(int argc, char** argv) {
+    int nodes = 1000000;
+    int churnNodes = 20000;
+    int churnOps = 20000;
+    unsigned int seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--nodes") == 0) nodes = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--churn-nodes") == 0) churnNodes = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--churn-ops") == 0) churnOps = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        else {
+            std::fprintf(stderr, "Usage: %s [--nodes N] [--seed S] [--churn-nodes N] [--churn-ops N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (nodes < 2) nodes = 2;
+    if (churnNodes < 2) churnNodes = 2;
+
+    std::mt19937 rng(seed);
+    bool ok = true;
+    {
+        churnHeap(rng, nodes);
+        SinglyLinkedList list;
+        list.setVerbose(false);
+        for (int i = 0; i < nodes; ++i) list.insertAt(0, static_cast<int>(rng() % 1000));
+
+        std::printf("%d nodes\n", nodes);
+        std::printf("%-10s %14s %14s %16s\n", "", "fragmentation", "traverse ms", "positional us/op");
+        Measured before = measure(list, rng);
+        std::printf("%-10s %14.3f %14.2f %16.1f\n", "scattered", list.fragmentation(),
+                    before.traverseSecs * 1e3, before.positionalSecs * 1e6);
+
+        unsigned long long scattered = listChecksum(list);
+        auto start = std::chrono::steady_clock::now();
+        list.compact();
+        double compactSecs = secondsSince(start);
+        unsigned long long compacted = listChecksum(list);
+
+        Measured after = measure(list, rng);
+        std::printf("%-10s %14.3f %14.2f %16.1f\n", "compacted", list.fragmentation(),
+                    after.traverseSecs * 1e3, after.positionalSecs * 1e6);
+        std::printf("compact() took %.2f ms; traversal %.1fx faster\n", compactSecs * 1e3,
+                    after.traverseSecs > 0 ? before.traverseSecs / after.traverseSecs : 0.0);
+        if (compacted != scattered) {
+            std::printf("checksum changed by compact()\n");
+            ok = false;
+        }
+    }
+
+    std::printf("\nrandom ops on %d nodes, %d rounds\n", churnNodes, churnOps);
+    SinglyLinkedList plain, autoCompacted;
+    plain.setVerbose(false);
+    autoCompacted.setVerbose(false);
+    autoCompacted.setAutoCompact(0.5);
+    double plainSecs = churnList(plain, seed, churnNodes, churnOps);
+    double autoSecs = churnList(autoCompacted, seed, churnNodes, churnOps);
+    std::printf("%-16s %8.3fs  fragmentation %.3f\n", "no compaction", plainSecs, plain.fragmentation());
+    std::printf("%-16s %8.3fs  fragmentation %.3f  (%d compactions)\n", "auto at 0.5", autoSecs,
+                autoCompacted.fragmentation(), autoCompacted.getCompactions());
+    if (listChecksum(plain) != listChecksum(autoCompacted)) {
+        std::printf("checksum mismatch between runs\n");
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+/*
+ * DeferredFree.cpp
+ *
+ * Delete latency with the node freed inline versus deferred.
+ *
+ *   ChatGPTPaid  inline      delete_at(list, pos)
+ *                quiescent   delete_at(list, pos, retired); retire_flush()
+ *                            every --batch deletes, between operations
+ *   ClaudePaid   inline      deleteAt() with the default inline delete
+ *                quiescent   nodes released into a RetireQueue (Reclaimer.h)
+ *                            through the NodeSource hook; reclaim() every
+ *                            --batch deletes, between operations
+ *                background  the RetireQueue hands every --batch nodes to a
+ *                            Reclaimer thread
+ *
+ * All runs replay one planned op stream on a list prefilled to --nodes: bursts
+ * of mostly-inserts and mostly-deletes alternate, so the heap grows and
+ * shrinks (and glibc trims) as it would under the programs' churn. Positions
+ * fall in the first --window nodes, so the walk is short and the allocator's
+ * share of a delete is visible; --window 0 spreads them over the whole list.
+ *
+ * Every delete is timed (CycleClock) into a LatencyHistogram; the batch frees
+ * on the list thread are timed separately and included in the total. Each run
+ * is a forked child and must end on the same checksum.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -o DeferredFree DeferredFree.cpp
+ * Run:   ./DeferredFree [--nodes N] [--ops N] [--window N] [--batch N] [--seed S]
+ */
+
+#include "ListAdapters.h"
+#include "LatencyHistogram.h"
+#include "Reclaimer.h"
+
+struct PlannedOp {
+    bool erase;
+    int pos;
+    int value;
+};
+
+struct Options {
+    int nodes = 100000;
+    int ops = 2000000;
+    int window = 64;
+    int batch = 256;
+    unsigned int seed = 1;
+};
+
+// Alternating bursts of 4096 ops: 3/4 inserts, then 3/4 deletes.
+static PlannedOp* planOps(const Options& opt) {
+    std::mt19937 rng(opt.seed);
+    PlannedOp* plan = new PlannedOp[opt.ops];
+    int size = opt.nodes;
+    for (int i = 0; i < opt.ops; ++i) {
+        bool growing = (i / 4096) % 2 == 0;
+        bool erase = size > 0 && static_cast<int>(rng() % 4) < (growing ? 1 : 3);
+        int span = erase ? size : size + 1;
+        if (opt.window > 0 && span > opt.window) span = opt.window;
+        plan[i] = {erase, static_cast<int>(rng() % span), static_cast<int>(rng() % 1000)};
+        size += erase ? -1 : 1;
+    }
+    return plan;
+}
+
+struct RunStats {
+    LatencyHistogram deletes;
+    std::uint64_t flushTicks = 0;
+    std::uint64_t totalTicks = 0;
+    unsigned long long checksum = 0;
+};
+
+enum Mode { INLINE, QUIESCENT, BACKGROUND };
+static const char* const kModeNames[] = {"inline", "quiescent", "background"};
+
+static void runChatGPTPaid(Mode mode, const Options& opt, const PlannedOp* plan, RunStats& st) {
+    using namespace chatgpt_paid;
+    List list;
+    RetireList retired;
+    for (int i = 0; i < opt.nodes; ++i) push_front(list, static_cast<int>(i % 1000));
+    std::uint64_t begin = CycleClock::now();
+    for (int i = 0; i < opt.ops; ++i) {
+        const PlannedOp& p = plan[i];
+        if (!p.erase) {
+            insert_at(list, p.pos, p.value);
+            continue;
+        }
+        std::uint64_t t0 = CycleClock::now();
+        if (mode == INLINE) delete_at(list, p.pos);
+        else delete_at(list, p.pos, retired);
+        std::uint64_t t1 = CycleClock::now();
+        st.deletes.record(t1 - t0);
+        if (retired.count >= opt.batch) {
+            retire_flush(retired);
+            st.flushTicks += CycleClock::now() - t1;
+        }
+    }
+    std::uint64_t t1 = CycleClock::now();
+    retire_flush(retired);
+    std::uint64_t end = CycleClock::now();
+    st.flushTicks += end - t1;
+    st.totalTicks = end - begin;
+    st.checksum = chainChecksum(list.head, &Node::value);
+    free_list(list);
+}
+
+// Parks the list's released nodes instead of deleting them.
+struct RetiringSource : claude_paid::NodeSource {
+    RetireQueue<claude_paid::Node>& retired;
+    explicit RetiringSource(RetireQueue<claude_paid::Node>& retired) : retired(retired) {}
+    void* allocate() override { return nullptr; }
+    void release(claude_paid::Node* n) override { retired.retire(n); }
+};
+
+// `retired` is only plugged in for the deferred modes; it outlives the list,
+// which releases its remaining nodes into it when destroyed.
+static void runClaudePaid(Mode mode, const Options& opt, const PlannedOp* plan, RunStats& st,
+                          RetireQueue<claude_paid::Node>& retired) {
+    RetiringSource source(retired);
+    claude_paid::SinglyLinkedList list;
+    list.setVerbose(false);
+    if (mode != INLINE) list.setNodeSource(&source);
+    for (int i = 0; i < opt.nodes; ++i) list.insertAt(0, static_cast<int>(i % 1000));
+    std::uint64_t begin = CycleClock::now();
+    for (int i = 0; i < opt.ops; ++i) {
+        const PlannedOp& p = plan[i];
+        if (!p.erase) {
+            list.insertAt(p.pos, p.value);
+            continue;
+        }
+        std::uint64_t t0 = CycleClock::now();
+        list.deleteAt(p.pos);
+        std::uint64_t t1 = CycleClock::now();
+        st.deletes.record(t1 - t0);
+        if (mode == QUIESCENT && retired.size() >= opt.batch) {
+            retired.reclaim();
+            st.flushTicks += CycleClock::now() - t1;
+        }
+    }
+    std::uint64_t t1 = CycleClock::now();
+    retired.reclaim();
+    std::uint64_t end = CycleClock::now();
+    st.flushTicks += end - t1;
+    st.totalTicks = end - begin;
+    st.checksum = listChecksum(list);
+}
+
+static void runClaudePaid(Mode mode, const Options& opt, const PlannedOp* plan, RunStats& st) {
+    if (mode == BACKGROUND) {
+        Reclaimer<claude_paid::Node> reclaimer;
+        RetireQueue<claude_paid::Node> retired(reclaimer, opt.batch);
+        runClaudePaid(mode, opt, plan, st, retired);
+    } else {
+        RetireQueue<claude_paid::Node> retired;
+        runClaudePaid(mode, opt, plan, st, retired);
+    }
+}
+
+static void printRow(const char* impl, Mode mode, const RunStats& st) {
+    double ns = CycleClock::nsPerTick();
+    const LatencyHistogram& h = st.deletes;
+    std::printf("%-12s %-11s %8.0f %8.0f %8.0f %9.0f %9.0f %10.1f %9.1f  %016llx\n", impl, kModeNames[mode],
+                h.mean() * ns, h.percentile(0.5) * ns, h.percentile(0.99) * ns, h.percentile(0.999) * ns,
+                h.max() * ns, st.totalTicks * ns / 1e6, st.flushTicks * ns / 1e6, st.checksum);
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--nodes") == 0) opt.nodes = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--ops") == 0) opt.ops = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--window") == 0) opt.window = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--batch") == 0) opt.batch = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seed") == 0) opt.seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        else {
+            std::fprintf(stderr, "Usage: %s [--nodes N] [--ops N] [--window N] [--batch N] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (opt.nodes < 0 || opt.ops < 1 || opt.window < 0 || opt.batch < 1) {
+        std::fprintf(stderr, "Usage: %s [--nodes N] [--ops N] [--window N] [--batch N] [--seed S]\n", argv[0]);
+        return 2;
+    }
+
+    PlannedOp* plan = planOps(opt);
+    std::printf("%d nodes, %d ops, positions in the first %d, batch %d\n\n", opt.nodes, opt.ops,
+                opt.window, opt.batch);
+    std::printf("%-12s %-11s %8s %8s %8s %9s %9s %10s %9s  %s\n", "list", "free", "mean ns", "p50 ns", "p99 ns",
+                "p99.9 ns", "max ns", "total ms", "flush ms", "checksum");
+
+    // The inline ChatGPTPaid run in the parent fixes the expected checksum;
+    // every child must end on it.
+    unsigned long long expected;
+    {
+        RunStats* st = new RunStats;
+        runChatGPTPaid(INLINE, opt, plan, *st);
+        expected = st->checksum;
+        delete st;
+    }
+    struct Run {
+        const char* impl;
+        Mode mode;
+    } runs[] = {
+        {"ChatGPTPaid", INLINE}, {"ChatGPTPaid", QUIESCENT}, {"ClaudePaid", INLINE},
+        {"ClaudePaid", QUIESCENT}, {"ClaudePaid", BACKGROUND},
+    };
+    bool ok = true;
+    for (const Run& r : runs) {
+        ok = runIsolated(r.impl, [&] {
+            RunStats* st = new RunStats;
+            if (std::strcmp(r.impl, "ChatGPTPaid") == 0) runChatGPTPaid(r.mode, opt, plan, *st);
+            else runClaudePaid(r.mode, opt, plan, *st);
+            printRow(r.impl, r.mode, *st);
+            bool same = st->checksum == expected;
+            delete st;
+            if (!same) {
+                std::printf("  checksum differs from the inline run\n");
+                std::fflush(stdout);
+                _exit(1);
+            }
+        }) && ok;
+    }
+    std::printf("(delete latency per op; total includes the flushes done on the list thread)\n");
+    delete[] plan;
+    return ok ? 0 : 1;
+}
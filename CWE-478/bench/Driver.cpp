@@ -0,0 +1,177 @@
+/*
+ * Driver.cpp
+ *
+ * Seeded, silent, timed workload for the eight CWE-478 lists. The programs'
+ * own main() loops seed from the clock and print a line per operation, so
+ * their runs can be neither repeated nor compared; this drives every list
+ * through ListAdapters.h with one op stream instead:
+ *
+ *   add     insert a value at the front
+ *   delete  erase a random index
+ *   insert  insert a value at a random index (0..size)
+ *   move    move a random index to a random index of the list without it
+ *
+ * picked by the --mix weights until the list holds --target nodes or --max-ops
+ * (default 50 * target + 1000) have run. Every draw depends only on the seed
+ * and the current size, so lists that behave correctly end on the same
+ * checksum. Each list prints one line: ops, elapsed time, ops/sec, final size
+ * and the FNV-1a checksum of its values in order. --record writes the op
+ * stream of a single list's run to a trace for TraceReplay (OpTrace.h).
+ *
+ * Each list runs in a forked child, so CopilotFree's moveNode() corrupting
+ * its chain does not stop the others.
+ *
+ * Build: g++ -std=c++17 -O2 -o Driver Driver.cpp
+ * Run:   ./Driver [--impl NAME|all] [--seed N] [--target N] [--mix ADD,DEL,INS,MOVE]
+ *                 [--max-ops N] [--record TRACE_FILE]
+ */
+
+#include "ListAdapters.h"
+#include "OpTrace.h"
+
+struct Options {
+    const char* impl = "all";
+    unsigned int seed = 1;
+    int target = 100;
+    int mix[4] = {20, 30, 25, 25}; // add, delete, insert, move
+    long long maxOps = 0;          // 0 => derived from target
+    const char* recordPath = nullptr;
+};
+
+static int randInt(std::mt19937& rng, int lo, int hi) {
+    std::uniform_int_distribution<int> dist(lo, hi);
+    return dist(rng);
+}
+
+// Runs the workload on one list and prints its summary line; returns whether
+// the list reached the target size. With `trace` every applied op is recorded.
+template <typename List>
+static bool runDriver(List& list, const Options& opt, std::FILE* trace) {
+    std::mt19937 rng(opt.seed);
+    const int total = opt.mix[0] + opt.mix[1] + opt.mix[2] + opt.mix[3];
+    long long ops = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    while (ops < opt.maxOps) {
+        int len = list.size();
+        if (len == opt.target) break;
+
+        int roll = randInt(rng, 0, total - 1);
+        TraceCode op;
+        if (len == 0 || roll < opt.mix[0]) op = TRACE_ADD_FRONT;
+        else if (roll < opt.mix[0] + opt.mix[1]) op = TRACE_DELETE;
+        else if (roll < opt.mix[0] + opt.mix[1] + opt.mix[2]) op = TRACE_INSERT;
+        else op = TRACE_MOVE;
+
+        TraceOp t = {op, 0, 0};
+        switch (op) {
+            case TRACE_ADD_FRONT:
+                t.a = randInt(rng, -100000, 100000);
+                list.insert(0, t.a);
+                break;
+            case TRACE_DELETE:
+                t.a = randInt(rng, 0, len - 1);
+                list.erase(t.a);
+                break;
+            case TRACE_INSERT:
+                t.b = randInt(rng, -100000, 100000);
+                t.a = randInt(rng, 0, len);
+                list.insert(t.a, t.b);
+                break;
+            case TRACE_MOVE:
+                if (len <= 1) break;
+                t.a = randInt(rng, 0, len - 1);
+                t.b = randInt(rng, 0, len - 1);
+                list.move(t.a, t.b);
+                break;
+        }
+        if (trace && (op != TRACE_MOVE || len > 1)) traceWrite(trace, t);
+        ++ops;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int size = list.size();
+    std::printf("%s seed=%u target=%d reached=%s ops=%lld elapsed=%.3fs ops/sec=%.0f size=%d checksum=%016llx\n",
+                list.name, opt.seed, opt.target, size == opt.target ? "yes" : "no", ops, secs,
+                secs > 0 ? ops / secs : 0.0, size, list.checksum());
+    return size == opt.target;
+}
+
+/* ─── Main ────────────────────────────────────────────────────────── */
+
+static void printUsage(const char* prog) {
+    std::fprintf(stderr,
+                 "Usage: %s [--impl NAME|all] [--seed N] [--target N] [--mix ADD,DEL,INS,MOVE]\n"
+                 "          [--max-ops N] [--record TRACE_FILE]\n",
+                 prog);
+    std::fprintf(stderr, "  NAME is one of:");
+    for (int i = 0; i < kAdapterCount; ++i) std::fprintf(stderr, " %s", kAdapterNames[i]);
+    std::fprintf(stderr, "\n");
+}
+
+static bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char* arg = argv[i];
+        const char* val = argv[i + 1];
+        if (std::strcmp(arg, "--impl") == 0) opt.impl = val;
+        else if (std::strcmp(arg, "--seed") == 0) opt.seed = static_cast<unsigned int>(std::strtoul(val, nullptr, 10));
+        else if (std::strcmp(arg, "--target") == 0) opt.target = std::atoi(val);
+        else if (std::strcmp(arg, "--max-ops") == 0) opt.maxOps = std::atoll(val);
+        else if (std::strcmp(arg, "--record") == 0) opt.recordPath = val;
+        else if (std::strcmp(arg, "--mix") == 0) {
+            if (std::sscanf(val, "%d,%d,%d,%d", &opt.mix[0], &opt.mix[1], &opt.mix[2], &opt.mix[3]) != 4)
+                return false;
+        } else {
+            return false;
+        }
+    }
+    if (argc % 2 == 0) return false;
+    int total = 0;
+    for (int w : opt.mix) {
+        if (w < 0) return false;
+        total += w;
+    }
+    if (opt.target < 0 || total <= 0) return false;
+    if (opt.target > 0 && opt.mix[0] + opt.mix[2] <= opt.mix[1]) {
+        std::fprintf(stderr, "mix never grows the list (add + insert must exceed delete)\n");
+        return false;
+    }
+    if (opt.maxOps <= 0) opt.maxOps = 50LL * opt.target + 1000;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    bool all = std::strcmp(opt.impl, "all") == 0;
+    if (!all && !withAdapter(opt.impl, [](auto&) {})) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (all && opt.recordPath) {
+        std::fprintf(stderr, "--record needs a single --impl\n");
+        return 2;
+    }
+
+    bool ok = true;
+    for (int i = 0; i < kAdapterCount; ++i) {
+        const char* name = kAdapterNames[i];
+        if (!all && std::strcmp(opt.impl, name) != 0) continue;
+        ok = runIsolated(name, [&] {
+            std::FILE* trace = nullptr;
+            if (opt.recordPath && !(trace = traceOpenWrite(opt.recordPath))) {
+                std::perror(opt.recordPath);
+                _exit(2);
+            }
+            bool reached = false;
+            withAdapter(name, [&](auto& list) { reached = runDriver(list, opt, trace); });
+            if (trace) std::fclose(trace);
+            std::fflush(stdout);
+            if (!reached) _exit(1);
+        }) && ok;
+    }
+    return ok ? 0 : 1;
+}
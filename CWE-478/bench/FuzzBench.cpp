@@ -0,0 +1,403 @@
+/*
+ * FuzzBench.cpp
+ *
+ * One harness over all eight CWE-478 lists, driven through ListAdapters.h:
+ *
+ *   1. Differential fuzz: a seeded stream of inserts, erases and moves, biased
+ *      towards the ends of the list, is applied to each list and to ArrayModel
+ *      (a plain int array with the same positional interface). Size and
+ *      checksum are compared after every operation, so the first divergence is
+ *      reported with the op that caused it. The list stays small (--fuzz-size)
+ *      and repeatedly drains to empty, so the head/tail/single-node cases come
+ *      up constantly.
+ *   2. Benchmark: every list is prefilled to --nodes and replays the same
+ *      seeded op mix (add-end, delete, insert, move weights as in OpLatency),
+ *      and must end on the checksum ArrayModel reaches on that mix.
+ *
+ * Memory comes from a counting allocator: this file replaces the global
+ * operator new/delete, so every node the programs allocate is counted (calls
+ * and malloc_usable_size() bytes). Per list it reports live bytes per node
+ * after the prefill, the peak, allocations per timed op, and what is still
+ * allocated once the list has been destroyed (the leak count).
+ *
+ * Each list runs in a forked child; a crash is reported and the others go on.
+ * Exits non-zero if any list diverges, leaks or crashes.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -o FuzzBench FuzzBench.cpp
+ * Run:   ./FuzzBench [--impl NAME|all] [--fuzz-ops N] [--fuzz-size N]
+ *                    [--nodes N] [--ops N] [--mix ADD,DEL,INS,MOVE] [--seed S]
+ */
+
+#include "ListAdapters.h"
+
+#include <atomic>
+
+#include <malloc.h>
+
+/* ─── Counting allocator ──────────────────────────────────────────── */
+
+struct AllocCounts {
+    unsigned long long allocs;
+    unsigned long long frees;
+    long long liveBytes;
+    long long peakBytes;
+};
+
+static std::atomic<unsigned long long> gAllocs(0);
+static std::atomic<unsigned long long> gFrees(0);
+static std::atomic<long long> gLiveBytes(0);
+static std::atomic<long long> gPeakBytes(0);
+
+static AllocCounts allocSnapshot() {
+    return {gAllocs.load(std::memory_order_relaxed), gFrees.load(std::memory_order_relaxed),
+            gLiveBytes.load(std::memory_order_relaxed), gPeakBytes.load(std::memory_order_relaxed)};
+}
+
+// Restarts the peak from the current live size.
+static void resetPeak() { gPeakBytes.store(gLiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+static void* countedAlloc(std::size_t size, bool nothrow) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) {
+        if (nothrow) return nullptr;
+        throw std::bad_alloc();
+    }
+    long long bytes = static_cast<long long>(malloc_usable_size(p));
+    gAllocs.fetch_add(1, std::memory_order_relaxed);
+    long long live = gLiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    long long peak = gPeakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !gPeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    return p;
+}
+
+static void countedFree(void* p) {
+    if (!p) return;
+    gFrees.fetch_add(1, std::memory_order_relaxed);
+    gLiveBytes.fetch_sub(static_cast<long long>(malloc_usable_size(p)), std::memory_order_relaxed);
+    std::free(p);
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size, false); }
+void* operator new[](std::size_t size) { return countedAlloc(size, false); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size, true); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size, true); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+
+/* ─── Reference model ─────────────────────────────────────────────── */
+
+// The adapters' interface over a plain array; what every list must match.
+struct ArrayModel {
+    static constexpr const char* name = "ArrayModel";
+    int* values;
+    int count = 0;
+    int capacity;
+
+    explicit ArrayModel(int cap) : values(new int[cap > 0 ? cap : 1]), capacity(cap > 0 ? cap : 1) {}
+    ~ArrayModel() { delete[] values; }
+    ArrayModel(const ArrayModel&) = delete;
+    ArrayModel& operator=(const ArrayModel&) = delete;
+
+    int size() const { return count; }
+
+    void insert(int pos, int value) {
+        if (count == capacity) grow();
+        std::memmove(values + pos + 1, values + pos, sizeof(int) * (count - pos));
+        values[pos] = value;
+        ++count;
+    }
+
+    void erase(int pos) {
+        std::memmove(values + pos, values + pos + 1, sizeof(int) * (count - pos - 1));
+        --count;
+    }
+
+    void move(int from, int to) {
+        int v = values[from];
+        erase(from);
+        insert(to, v);
+    }
+
+    unsigned long long checksum() const {
+        unsigned long long h = kChecksumSeed;
+        for (int i = 0; i < count; ++i) checksumMix(h, values[i]);
+        return h;
+    }
+
+private:
+    void grow() {
+        int* bigger = new int[capacity * 2];
+        std::memcpy(bigger, values, sizeof(int) * count);
+        delete[] values;
+        values = bigger;
+        capacity *= 2;
+    }
+};
+
+/* ─── Op stream ───────────────────────────────────────────────────── */
+
+enum OpType { OP_ADD_END, OP_DELETE, OP_INSERT, OP_MOVE, OP_TYPES };
+static const char* const kOpNames[OP_TYPES] = {"add_end", "delete", "insert", "move"};
+
+struct Op {
+    OpType type;
+    int a;  // position (add_end/insert/delete) or source (move)
+    int b;  // destination (move)
+    int value;
+};
+
+// Applies op to any adapter-shaped list.
+template <typename List>
+static void apply(List& list, const Op& op) {
+    switch (op.type) {
+        case OP_ADD_END:
+        case OP_INSERT: list.insert(op.a, op.value); break;
+        case OP_DELETE: list.erase(op.a); break;
+        default: list.move(op.a, op.b); break;
+    }
+}
+
+static void describe(char* buf, size_t len, const Op& op) {
+    if (op.type == OP_MOVE) std::snprintf(buf, len, "move(%d, %d)", op.a, op.b);
+    else if (op.type == OP_DELETE) std::snprintf(buf, len, "delete(%d)", op.a);
+    else std::snprintf(buf, len, "%s(%d, %d)", kOpNames[op.type], op.a, op.value);
+}
+
+// A position in [0, span): one time in four an end (0 or span - 1), where the
+// head and tail special cases live; otherwise uniform.
+static int fuzzPosition(std::mt19937& rng, int span) {
+    unsigned int r = rng();
+    if (r % 4 == 0) return (r / 4) % 2 ? span - 1 : 0;
+    return static_cast<int>(rng() % span);
+}
+
+// Inserts and erases are equally likely, so the size random-walks between
+// empty and maxSize (erases only at the cap).
+static Op nextFuzzOp(std::mt19937& rng, int size, int maxSize) {
+    Op op;
+    op.value = static_cast<int>(rng() % 1000);
+    op.b = 0;
+    int roll = static_cast<int>(rng() % 3);
+    if (size == 0 || (roll == 0 && size < maxSize)) {
+        op.type = OP_INSERT;
+        op.a = fuzzPosition(rng, size + 1);
+    } else if (roll == 1 || size == 1 || size >= maxSize) {
+        op.type = OP_DELETE;
+        op.a = fuzzPosition(rng, size);
+    } else {
+        op.type = OP_MOVE;
+        op.a = fuzzPosition(rng, size);
+        op.b = fuzzPosition(rng, size);
+    }
+    return op;
+}
+
+struct Options {
+    const char* impl = "all";
+    long long fuzzOps = 200000;
+    int fuzzSize = 40;
+    int nodes = 10000;
+    long long ops = 50000;
+    int mix[OP_TYPES] = {20, 40, 20, 20};
+    unsigned int seed = 1;
+};
+
+// The benchmark mix, as OpLatency draws it; sizes follow the model, so every
+// list sees the same positions.
+static Op nextMixOp(std::mt19937& rng, const Options& opt, int size) {
+    const int total = opt.mix[0] + opt.mix[1] + opt.mix[2] + opt.mix[3];
+    int roll = static_cast<int>(rng() % total);
+    int t = 0;
+    while (roll >= opt.mix[t]) roll -= opt.mix[t++];
+    if (size < 2) t = OP_ADD_END;
+    Op op;
+    op.type = static_cast<OpType>(t);
+    op.a = static_cast<int>(rng() % (size + 1));
+    op.b = static_cast<int>(rng() % (size + 1));
+    op.value = static_cast<int>(rng() % 1000);
+    if (op.type == OP_ADD_END) op.a = size;
+    else if (op.type == OP_DELETE) op.a %= size;
+    else if (op.type == OP_MOVE) {
+        op.a %= size;
+        op.b %= size;
+    }
+    return op;
+}
+
+// Plans the prefill and timed ops, and runs them on the model for the
+// expected checksum.
+static Op* planMix(const Options& opt, unsigned long long& expected) {
+    std::mt19937 rng(opt.seed);
+    Op* plan = new Op[opt.nodes + opt.ops];
+    ArrayModel model(opt.nodes + 16);
+    for (int i = 0; i < opt.nodes; ++i) {
+        plan[i] = {OP_INSERT, 0, 0, static_cast<int>(rng() % 1000)};
+        apply(model, plan[i]);
+    }
+    for (long long i = 0; i < opt.ops; ++i) {
+        Op& op = plan[opt.nodes + i];
+        op = nextMixOp(rng, opt, model.size());
+        apply(model, op);
+    }
+    expected = model.checksum();
+    return plan;
+}
+
+/* ─── Fuzz ────────────────────────────────────────────────────────── */
+
+struct FuzzResult {
+    long long opsRun;
+    bool diverged;
+    char detail[160];
+};
+
+template <typename List>
+static void fuzzList(List& list, const Options& opt, FuzzResult& r) {
+    std::mt19937 rng(opt.seed);
+    ArrayModel model(opt.fuzzSize + 1);
+    r.diverged = false;
+    for (r.opsRun = 0; r.opsRun < opt.fuzzOps; ++r.opsRun) {
+        Op op = nextFuzzOp(rng, model.size(), opt.fuzzSize);
+        apply(model, op);
+        apply(list, op);
+        int got = list.size();
+        if (got != model.size() || list.checksum() != model.checksum()) {
+            char what[64];
+            describe(what, sizeof(what), op);
+            std::snprintf(r.detail, sizeof(r.detail), "op %lld %s: size %d, expected %d%s", r.opsRun, what, got,
+                          model.size(), got == model.size() ? " (contents differ)" : "");
+            r.diverged = true;
+            ++r.opsRun;
+            return;
+        }
+    }
+}
+
+static bool runFuzz(const char* name, const Options& opt) {
+    return runIsolated(name, [&] {
+        FuzzResult r;
+        AllocCounts before = allocSnapshot();
+        withAdapter(name, [&](auto& list) { fuzzList(list, opt, r); });
+        AllocCounts after = allocSnapshot();
+        unsigned long long leaked = (after.allocs - before.allocs) - (after.frees - before.frees);
+        std::printf("%-12s %10lld %-9s %8llu %10lld  %s\n", name, r.opsRun, r.diverged ? "DIVERGED" : "ok", leaked,
+                    after.liveBytes - before.liveBytes, r.diverged ? r.detail : "");
+        std::fflush(stdout);
+        if (r.diverged || leaked) _exit(1);
+    });
+}
+
+/* ─── Benchmark ───────────────────────────────────────────────────── */
+
+template <typename List>
+static double benchList(List& list, const Options& opt, const Op* plan, AllocCounts& filled, AllocCounts& done) {
+    for (int i = 0; i < opt.nodes; ++i) apply(list, plan[i]);
+    filled = allocSnapshot();
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < opt.ops; ++i) apply(list, plan[opt.nodes + i]);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    done = allocSnapshot();
+    return secs;
+}
+
+static bool runBench(const char* name, const Options& opt, const Op* plan, unsigned long long expected) {
+    return runIsolated(name, [&] {
+        AllocCounts before = allocSnapshot();
+        resetPeak();
+        AllocCounts filled, done;
+        double secs = 0;
+        unsigned long long sum = 0;
+        int size = 0;
+        withAdapter(name, [&](auto& list) {
+            secs = benchList(list, opt, plan, filled, done);
+            sum = list.checksum();
+            size = list.size();
+        });
+        AllocCounts after = allocSnapshot();
+        unsigned long long leaked = (after.allocs - before.allocs) - (after.frees - before.frees);
+        double perNode = opt.nodes > 0 ? static_cast<double>(filled.liveBytes - before.liveBytes) / opt.nodes : 0.0;
+        std::printf("%-12s %12.0f %9.1f %10.1f %9.3f %8llu %10lld %8d  %016llx%s\n", name, opt.ops / secs, perNode,
+                    (done.peakBytes - before.liveBytes) / 1024.0,
+                    static_cast<double>(done.allocs - filled.allocs) / opt.ops, leaked,
+                    after.liveBytes - before.liveBytes, size, sum, sum == expected ? "" : "  checksum differs");
+        std::fflush(stdout);
+        if (sum != expected || leaked) _exit(1);
+    });
+}
+
+/* ─── Main ────────────────────────────────────────────────────────── */
+
+static void printUsage(const char* prog) {
+    std::fprintf(stderr,
+                 "Usage: %s [--impl NAME|all] [--fuzz-ops N] [--fuzz-size N]\n"
+                 "          [--nodes N] [--ops N] [--mix ADD,DEL,INS,MOVE] [--seed S]\n",
+                 prog);
+}
+
+static bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char* arg = argv[i];
+        const char* val = argv[i + 1];
+        if (std::strcmp(arg, "--impl") == 0) opt.impl = val;
+        else if (std::strcmp(arg, "--fuzz-ops") == 0) opt.fuzzOps = std::atoll(val);
+        else if (std::strcmp(arg, "--fuzz-size") == 0) opt.fuzzSize = std::atoi(val);
+        else if (std::strcmp(arg, "--nodes") == 0) opt.nodes = std::atoi(val);
+        else if (std::strcmp(arg, "--ops") == 0) opt.ops = std::atoll(val);
+        else if (std::strcmp(arg, "--seed") == 0) opt.seed = static_cast<unsigned int>(std::strtoul(val, nullptr, 10));
+        else if (std::strcmp(arg, "--mix") == 0) {
+            if (std::sscanf(val, "%d,%d,%d,%d", &opt.mix[0], &opt.mix[1], &opt.mix[2], &opt.mix[3]) != 4)
+                return false;
+        } else {
+            return false;
+        }
+    }
+    if (argc % 2 == 0) return false;
+    int total = 0;
+    for (int w : opt.mix) {
+        if (w < 0) return false;
+        total += w;
+    }
+    return total > 0 && opt.fuzzOps >= 0 && opt.fuzzSize >= 1 && opt.nodes >= 0 && opt.ops > 0;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    bool all = std::strcmp(opt.impl, "all") == 0;
+    if (!all && !withAdapter(opt.impl, [](auto&) {})) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    bool ok = true;
+
+    std::printf("fuzz: %lld ops per list, size 0..%d, seed %u\n", opt.fuzzOps, opt.fuzzSize, opt.seed);
+    std::printf("%-12s %10s %-9s %8s %10s  %s\n", "list", "ops run", "result", "leaks", "leak B", "first divergence");
+    for (int i = 0; i < kAdapterCount; ++i) {
+        if (!all && std::strcmp(opt.impl, kAdapterNames[i]) != 0) continue;
+        ok = runFuzz(kAdapterNames[i], opt) && ok;
+    }
+
+    unsigned long long expected = 0;
+    Op* plan = planMix(opt, expected);
+    std::printf("\nbench: %d nodes, %lld ops, mix %d,%d,%d,%d (add-end,delete,insert,move), seed %u\n", opt.nodes,
+                opt.ops, opt.mix[0], opt.mix[1], opt.mix[2], opt.mix[3], opt.seed);
+    std::printf("%-12s %12s %9s %10s %9s %8s %10s %8s  %s\n", "list", "ops/sec", "B/node", "peak KiB", "allocs/op",
+                "leaks", "leak B", "size", "checksum");
+    for (int i = 0; i < kAdapterCount; ++i) {
+        if (!all && std::strcmp(opt.impl, kAdapterNames[i]) != 0) continue;
+        ok = runBench(kAdapterNames[i], opt, plan, expected) && ok;
+    }
+    std::printf("(expected checksum %016llx from ArrayModel; B/node is live heap after the prefill, leaks are\n"
+                " allocations still live after the list is destroyed)\n",
+                expected);
+    delete[] plan;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/*
+ * HugePageBench.cpp
+ *
+ * Traversal of a large ClaudePaid list with nodes from the heap, from a
+ * NodeArena (NodeArena.h) on small pages, and from one on huge pages.
+ *
+ * For each backing an N-node list (20M by default) is built twice:
+ *
+ *   ordered    nodes allocated in list order (a traversal streams memory)
+ *   scattered  the allocator's free slots shuffled first, so consecutive
+ *              nodes land on random pages; with 4 KiB pages almost every hop
+ *              is a TLB miss once the list outgrows the TLB's reach
+ *
+ * and traversed with listChecksum(), best of three. Reported per node: ns,
+ * dTLB load misses and dTLB loads (perf_event_open; "n/a" when the PMU is
+ * not available), plus how much of the process is on transparent huge pages
+ * (AnonHugePages from /proc/self/smaps_rollup), the arena's backing and
+ * the list's fragmentation().
+ * Each backing runs in a forked child and must reproduce the checksum of the
+ * value array.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -o HugePageBench HugePageBench.cpp
+ * Run:   ./HugePageBench [--nodes N] [--seed S]
+ */
+
+#include "ListAdapters.h"
+#include "NodeArena.h"
+#include "PerfCounters.h"
+
+using claude_paid::Node;
+using claude_paid::SinglyLinkedList;
+
+// Serves the list's nodes from an arena; nodes it did not hand out (the
+// arena was full) came from new.
+struct ArenaSource : claude_paid::NodeSource {
+    NodeArena* arena;
+    explicit ArenaSource(NodeArena* arena) : arena(arena) {}
+    void* allocate() override { return arena->allocate(); }
+    void release(Node* n) override {
+        if (arena->owns(n)) arena->release(n);
+        else delete n;
+    }
+};
+
+enum Backing { HEAP, ARENA_SMALL, ARENA_HUGE };
+static const char* const kBackingNames[] = {"heap", "arena", "arena+huge"};
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void shuffle(std::mt19937& rng, Node** nodes, int n) {
+    for (int i = n - 1; i > 0; --i) {
+        int j = static_cast<int>(rng() % (i + 1));
+        Node* t = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = t;
+    }
+}
+
+// Puts every slot on the free list (heap or arena) in random order, so the
+// list built next takes them in that order. Returns the scratch array for
+// the caller to free after the build: freeing (or allocating) a large block
+// first would make glibc consolidate its fast bins and hand the chunks back
+// in address order.
+static Node** scatterFreeSlots(std::mt19937& rng, NodeArena* arena, int n) {
+    Node** slots = new Node*[n];
+    for (int i = 0; i < n; ++i) slots[i] = arena ? new (arena->allocate()) Node(0) : new Node(0);
+    shuffle(rng, slots, n);
+    for (int i = 0; i < n; ++i) {
+        if (arena) arena->release(slots[i]);
+        else delete slots[i];
+    }
+    return slots;
+}
+
+static long long anonHugePagesKb() {
+    std::FILE* f = std::fopen("/proc/self/smaps_rollup", "r");
+    if (!f) return -1;
+    char line[256];
+    long long kb = -1;
+    while (std::fgets(line, sizeof(line), f))
+        if (std::sscanf(line, "AnonHugePages: %lld kB", &kb) == 1) break;
+    std::fclose(f);
+    return kb;
+}
+
+struct Traversal {
+    double nsPerNode;
+    std::uint64_t tlbMisses;
+    std::uint64_t tlbLoads;
+    unsigned long long checksum;
+};
+
+static Traversal traverse(const SinglyLinkedList& list, int n) {
+    PerfCounter misses(PerfCounter::DTLB_LOAD_MISSES);
+    PerfCounter loads(PerfCounter::DTLB_LOADS);
+    Traversal best = {1e18, 0, 0, 0};
+    for (int r = 0; r < 3; ++r) {
+        misses.start();
+        loads.start();
+        auto start = std::chrono::steady_clock::now();
+        unsigned long long sum = listChecksum(list);
+        double ns = secondsSince(start) * 1e9 / n;
+        std::uint64_t l = loads.stop();
+        std::uint64_t m = misses.stop();
+        if (ns < best.nsPerNode) best = {ns, m, l, sum};
+    }
+    if (!misses.available()) best.tlbMisses = ~0ULL;
+    if (!loads.available()) best.tlbLoads = ~0ULL;
+    return best;
+}
+
+static void printPerNode(std::uint64_t count, int n) {
+    if (count == ~0ULL) std::printf(" %10s", "n/a");
+    else std::printf(" %10.3f", static_cast<double>(count) / n);
+}
+
+static void runBacking(Backing backing, const int* values, int n, unsigned int seed, unsigned long long expected) {
+    bool ok = true;
+    for (int scattered = 0; scattered < 2; ++scattered) {
+        NodeArena* arena = backing == HEAP ? nullptr : new NodeArena(sizeof(Node), n, backing == ARENA_HUGE);
+        if (arena && arena->getCapacity() == 0) {
+            std::printf("%-11s mmap failed\n", kBackingNames[backing]);
+            delete arena;
+            _exit(1);
+        }
+        std::mt19937 rng(seed);
+        Node** scratch = scattered ? scatterFreeSlots(rng, arena, n) : nullptr;
+        double buildSecs;
+        Traversal t;
+        long long hugeKb;
+        double frag;
+        {
+            ArenaSource source(arena);
+            SinglyLinkedList list;
+            list.setVerbose(false);
+            if (arena) list.setNodeSource(&source);
+            auto start = std::chrono::steady_clock::now();
+            // Front inserts: no allocation other than the nodes themselves,
+            // which appendBulk()'s skip array would be.
+            for (int i = n - 1; i >= 0; --i) list.insertAt(0, values[i]);
+            buildSecs = secondsSince(start);
+            delete[] scratch;
+            t = traverse(list, n);
+            hugeKb = anonHugePagesKb();
+            frag = list.fragmentation();
+        }
+        std::printf("%-11s %-9s %-11s %9.2f %10.2f", kBackingNames[backing], scattered ? "scattered" : "ordered",
+                    arena ? NodeArena::backingName(arena->getBacking()) : "-", buildSecs, t.nsPerNode);
+        printPerNode(t.tlbMisses, n);
+        printPerNode(t.tlbLoads, n);
+        std::printf(" %10lld %10.3f\n", hugeKb / 1024, frag);
+        if (t.checksum != expected) {
+            std::printf("  checksum mismatch\n");
+            ok = false;
+        }
+        delete arena;
+    }
+    std::fflush(stdout);
+    if (!ok) _exit(1);
+}
+
+int main(int argc, char** argv) {
+    int nodes = 20000000;
+    unsigned int seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--nodes") == 0) nodes = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        else {
+            std::fprintf(stderr, "Usage: %s [--nodes N] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (nodes < 1) nodes = 1;
+
+    std::mt19937 rng(seed);
+    int* values = new int[nodes];
+    for (int i = 0; i < nodes; ++i) values[i] = static_cast<int>(rng() % 1000);
+    unsigned long long expected = 1469598103934665603ULL;
+    for (int i = 0; i < nodes; ++i) {
+        expected ^= static_cast<unsigned int>(values[i]);
+        expected *= 1099511628211ULL;
+    }
+
+    std::printf("%d nodes (%zu-byte Node)\n\n", nodes, sizeof(Node));
+    std::printf("%-11s %-9s %-11s %9s %10s %10s %10s %10s %10s\n", "nodes from", "order", "pages", "build s",
+                "ns/node", "dTLB miss", "dTLB load", "THP MiB", "far links");
+    bool ok = true;
+    for (int b = HEAP; b <= ARENA_HUGE; ++b) {
+        Backing backing = static_cast<Backing>(b);
+        ok = runIsolated(kBackingNames[b], [&] { runBacking(backing, values, nodes, seed, expected); }) && ok;
+    }
+    std::printf("(dTLB columns are per node; THP MiB is the process's AnonHugePages after the build;\n"
+                " far links is the list's fragmentation(), the share of hops longer than a cache line)\n");
+    delete[] values;
+    return ok ? 0 : 1;
+}
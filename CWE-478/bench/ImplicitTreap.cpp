@@ -0,0 +1,354 @@
+/*
+ * ImplicitTreap.cpp
+ *
+ * An O(log n) backend for the CWE-478 workload. The programs treat the list
+ * as a sequence with insert, delete and move at random indices, so every
+ * operation costs a walk. An implicit-key treap stores the same sequence as
+ * a randomized balanced tree ordered by position: each node keeps its subtree
+ * size, so "index i" is found by descending left/right on sizes, and
+ * insert/delete/move are a couple of split/merge calls.
+ *
+ * Raw pointers and new/delete only, like the programs themselves.
+ *
+ * The program runs:
+ *   1. a differential test: one seeded op stream applied to both the treap and
+ *      ChatGPTFree's SinglyLinkedList, with checksums compared along the way
+ *      and the final contents compared in full;
+ *   2. throughput for a balanced insert/delete/move mix at 1K, 100K and 10M
+ *      elements (the linked list is skipped at 10M).
+ *
+ * Build: g++ -std=c++17 -O2 -o ImplicitTreap ImplicitTreap.cpp
+ * Run:   ./ImplicitTreap [--seed S] [--diff-ops N] [--ops N] [--max-size N]
+ */
+
+#include "ListAdapters.h"
+
+class ImplicitTreap {
+private:
+    struct TNode {
+        int value;
+        unsigned int priority;
+        int size; // nodes in this subtree
+        TNode* left;
+        TNode* right;
+    };
+
+    TNode* root;
+    unsigned int rngState;
+
+    unsigned int nextPriority() {
+        // xorshift32: priorities only need to be independent of positions.
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return rngState;
+    }
+
+    TNode* makeNode(int value) { return new TNode{value, nextPriority(), 1, nullptr, nullptr}; }
+
+    static int sizeOf(const TNode* t) { return t ? t->size : 0; }
+    static void update(TNode* t) { t->size = 1 + sizeOf(t->left) + sizeOf(t->right); }
+
+    // Splits t into its first k nodes (l) and the rest (r).
+    static void split(TNode* t, int k, TNode*& l, TNode*& r) {
+        if (!t) {
+            l = r = nullptr;
+            return;
+        }
+        if (sizeOf(t->left) < k) {
+            split(t->right, k - sizeOf(t->left) - 1, t->right, r);
+            l = t;
+        } else {
+            split(t->left, k, l, t->left);
+            r = t;
+        }
+        update(t);
+    }
+
+    // Concatenates l then r; the higher priority becomes the root.
+    static TNode* merge(TNode* l, TNode* r) {
+        if (!l) return r;
+        if (!r) return l;
+        if (l->priority > r->priority) {
+            l->right = merge(l->right, r);
+            update(l);
+            return l;
+        }
+        r->left = merge(l, r->left);
+        update(r);
+        return r;
+    }
+
+    static void destroy(TNode* t) {
+        while (t) {
+            destroy(t->left);
+            TNode* right = t->right;
+            delete t;
+            t = right;
+        }
+    }
+
+    void linkAt(int index, TNode* n) {
+        TNode *a, *b;
+        split(root, index, a, b);
+        root = merge(merge(a, n), b);
+    }
+
+    TNode* unlinkAt(int index) {
+        TNode *a, *b, *mid;
+        split(root, index, a, b);
+        split(b, 1, mid, b);
+        root = merge(a, b);
+        return mid;
+    }
+
+    // In-order walk with an explicit stack; fn(value) per node.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        TNode* stack[128]; // treap height stays far below this for any size we can allocate
+        int top = 0;
+        TNode* cur = root;
+        while (cur || top > 0) {
+            while (cur) {
+                stack[top++] = cur;
+                cur = cur->left;
+            }
+            cur = stack[--top];
+            fn(cur->value);
+            cur = cur->right;
+        }
+    }
+
+public:
+    explicit ImplicitTreap(unsigned int seed = 1) : root(nullptr), rngState(seed ? seed : 1) {}
+    ~ImplicitTreap() { destroy(root); }
+
+    int getSize() const { return sizeOf(root); }
+
+    void pushBack(int value) { root = merge(root, makeNode(value)); }
+
+    // Builds the treap from values[0..n) in O(n) (Cartesian tree with a
+    // stack of the right spine); replaces any current contents.
+    void build(const int* values, int n) {
+        destroy(root);
+        root = nullptr;
+        TNode** spine = new TNode*[n > 0 ? n : 1];
+        int top = 0;
+        for (int i = 0; i < n; ++i) {
+            TNode* node = makeNode(values[i]);
+            TNode* last = nullptr;
+            while (top > 0 && spine[top - 1]->priority < node->priority) {
+                last = spine[--top];
+                update(last); // its right subtree is final once popped
+            }
+            node->left = last;
+            if (top > 0) spine[top - 1]->right = node;
+            spine[top++] = node;
+        }
+        // Sizes along the remaining spine are fixed bottom-up.
+        for (int i = top - 1; i >= 0; --i) update(spine[i]);
+        root = top > 0 ? spine[0] : nullptr;
+        delete[] spine;
+    }
+
+    void insertAt(int index, int value) {
+        if (index < 0) index = 0;
+        if (index > getSize()) index = getSize();
+        linkAt(index, makeNode(value));
+    }
+
+    void deleteAt(int index) {
+        if (index < 0 || index >= getSize()) return;
+        delete unlinkAt(index);
+    }
+
+    // Same semantics as ChatGPTFree's moveNode(): toIndex is a position in
+    // the list after the node is taken out.
+    void moveNode(int fromIndex, int toIndex) {
+        int size = getSize();
+        if (fromIndex < 0 || fromIndex >= size || toIndex < 0 || toIndex >= size || fromIndex == toIndex)
+            return;
+        linkAt(toIndex, unlinkAt(fromIndex));
+    }
+
+    int at(int index) const {
+        const TNode* t = root;
+        for (;;) {
+            int left = sizeOf(t->left);
+            if (index < left) {
+                t = t->left;
+            } else if (index == left) {
+                return t->value;
+            } else {
+                index -= left + 1;
+                t = t->right;
+            }
+        }
+    }
+
+    void toArray(int* out) const {
+        int i = 0;
+        forEach([&](int v) { out[i++] = v; });
+    }
+
+    unsigned long long checksum() const {
+        unsigned long long h = kChecksumSeed;
+        forEach([&h](int v) { checksumMix(h, v); });
+        return h;
+    }
+};
+
+/* ─── Differential test ───────────────────────────────────────────── */
+
+// Applies the same seeded stream of add-end / delete / insert / move to both
+// structures (the same shape of loop as ChatGPTFree's main()).
+static bool differentialTest(unsigned int seed, int ops) {
+    std::mt19937 rng(seed);
+    chatgpt_free::SinglyLinkedList list;
+    ImplicitTreap treap(seed);
+    int checks = 0;
+    for (int i = 0; i < ops; ++i) {
+        int size = list.getSize();
+        int op = size == 0 ? 0 : static_cast<int>(rng() % 4);
+        int value = static_cast<int>(rng() % 1000);
+        int a = static_cast<int>(rng() % (size + 1));
+        int b = static_cast<int>(rng() % (size + 1));
+        switch (op) {
+            case 0:
+                list.pushBack(value);
+                treap.pushBack(value);
+                break;
+            case 1:
+                list.deleteAt(a % size);
+                treap.deleteAt(a % size);
+                break;
+            case 2:
+                list.insertAt(a, value);
+                treap.insertAt(a, value);
+                break;
+            default:
+                // Out-of-range and same-index moves included on purpose.
+                list.moveNode(a, b);
+                treap.moveNode(a, b);
+                break;
+        }
+        if (i % 256 == 0 || i == ops - 1) {
+            ++checks;
+            if (list.getSize() != treap.getSize() || listChecksum(list) != treap.checksum()) {
+                std::printf("differential: mismatch after op %d (size %d vs %d)\n", i, list.getSize(),
+                            treap.getSize());
+                return false;
+            }
+        }
+    }
+
+    // Full contents: toArray() must agree with at(i) at every index, and a
+    // list rebuilt from that array must hash the same as the original.
+    int n = treap.getSize();
+    int* values = new int[n > 0 ? n : 1];
+    treap.toArray(values);
+    bool same = true;
+    for (int i = 0; i < n && same; ++i) same = treap.at(i) == values[i];
+    chatgpt_free::SinglyLinkedList rebuilt;
+    for (int i = 0; i < n; ++i) rebuilt.pushBack(values[i]);
+    same = same && listChecksum(rebuilt) == listChecksum(list);
+    delete[] values;
+
+    std::printf("differential: %d ops, %d checkpoints, final size %d: %s\n", ops, checks, n,
+                same ? "contents match" : "CONTENTS DIFFER");
+    return same;
+}
+
+/* ─── Throughput ──────────────────────────────────────────────────── */
+
+struct PlannedOp {
+    int kind; // 0 insert, 1 delete, 2 move
+    int a;
+    int b;
+    int value;
+};
+
+// Insert and delete alternate, so the size stays at n or n + 1.
+static void planOps(std::mt19937& rng, int n, PlannedOp* plan, int count) {
+    int size = n;
+    for (int i = 0; i < count; ++i) {
+        PlannedOp& p = plan[i];
+        p.kind = static_cast<int>(rng() % 3);
+        if (p.kind != 2) p.kind = size > n ? 1 : 0;
+        p.a = static_cast<int>(rng() % (p.kind == 0 ? size + 1 : size));
+        p.b = static_cast<int>(rng() % size);
+        p.value = static_cast<int>(rng() % 1000);
+        if (p.kind == 0) ++size;
+        else if (p.kind == 1) --size;
+    }
+}
+
+template <typename List>
+static double timeOps(List& list, const PlannedOp* plan, int count) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        const PlannedOp& p = plan[i];
+        if (p.kind == 0) list.insertAt(p.a, p.value);
+        else if (p.kind == 1) list.deleteAt(p.a);
+        else list.moveNode(p.a, p.b);
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return secs > 0 ? count / secs : 0.0;
+}
+
+int main(int argc, char** argv) {
+    unsigned int seed = 1;
+    int diffOps = 50000;
+    int ops = 200000;
+    int maxSize = 10000000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        else if (std::strcmp(argv[i], "--diff-ops") == 0) diffOps = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--ops") == 0) ops = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--max-size") == 0) maxSize = std::atoi(argv[i + 1]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--seed S] [--diff-ops N] [--ops N] [--max-size N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (ops < 1) ops = 1;
+
+    bool ok = differentialTest(seed, diffOps);
+
+    // The list walks ~n/2 nodes per op; give it fewer ops at larger sizes
+    // so the run stays short, and none at 10M.
+    const int sizes[] = {1000, 100000, 10000000};
+    PlannedOp* plan = new PlannedOp[ops];
+    std::printf("\n%10s %16s %16s %10s\n", "elements", "treap ops/s", "list ops/s", "speedup");
+    for (int n : sizes) {
+        if (n > maxSize) break;
+        std::mt19937 rng(seed + n);
+        int* values = new int[n];
+        for (int i = 0; i < n; ++i) values[i] = static_cast<int>(rng() % 1000);
+        planOps(rng, n, plan, ops);
+
+        ImplicitTreap treap(seed);
+        treap.build(values, n);
+        double treapRate = timeOps(treap, plan, ops);
+
+        double listRate = 0;
+        if (n <= 100000) {
+            chatgpt_free::SinglyLinkedList list;
+            for (int i = n - 1; i >= 0; --i) list.insertAt(0, values[i]);
+            int listOps = n <= 1000 ? ops : ops / 100;
+            listRate = timeOps(list, plan, listOps);
+            if (listOps == ops && listChecksum(list) != treap.checksum()) {
+                std::printf("throughput run diverged at n=%d\n", n);
+                ok = false;
+            }
+        }
+        delete[] values;
+
+        if (listRate > 0)
+            std::printf("%10d %16.0f %16.0f %9.0fx\n", n, treapRate, listRate, treapRate / listRate);
+        else
+            std::printf("%10d %16.0f %16s %10s\n", n, treapRate, "(skipped)", "");
+    }
+    delete[] plan;
+    return ok ? 0 : 1;
+}
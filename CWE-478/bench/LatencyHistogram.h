@@ -0,0 +1,132 @@
+/*
+ * LatencyHistogram.h
+ *
+ * Cheap latency recording for the bench tools.
+ *
+ *   CycleClock        rdtsc on x86 (calibrated once against steady_clock),
+ *                     steady_clock ticks elsewhere
+ *   LatencyHistogram  log-linear buckets over 64-bit tick counts: values
+ *                     below 32 are exact, above that every power of two is
+ *                     split into 32 linear sub-buckets (~3% relative error).
+ *                     record() is a count-leading-zeros, two shifts and an
+ *                     increment; percentiles are read at report time.
+ *
+ * Header-only and allocation-free so it can sit inside a timed loop.
+ */
+
+#ifndef CWE478_LATENCY_HISTOGRAM_H
+#define CWE478_LATENCY_HISTOGRAM_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CWE478_HAVE_RDTSC 1
+#endif
+
+class CycleClock {
+public:
+    static std::uint64_t now() {
+#ifdef CWE478_HAVE_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // Nanoseconds per tick; the first call spins ~20 ms to calibrate rdtsc.
+    static double nsPerTick() {
+        static const double ns = calibrate();
+        return ns;
+    }
+
+private:
+    static double calibrate() {
+#ifdef CWE478_HAVE_RDTSC
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t t0 = now();
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(20)) {
+        }
+        std::uint64_t t1 = now();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return t1 > t0 ? ns / static_cast<double>(t1 - t0) : 1.0;
+#else
+        return 1e9 * std::chrono::steady_clock::period::num / std::chrono::steady_clock::period::den;
+#endif
+    }
+};
+
+class LatencyHistogram {
+public:
+    static const int kSubBits = 5;
+    static const int kSub = 1 << kSubBits;
+    static const int kBuckets = (64 - kSubBits + 1) * kSub;
+
+    LatencyHistogram() { reset(); }
+
+    void reset() {
+        std::memset(counts, 0, sizeof(counts));
+        total = 0;
+        sum = 0;
+        maxValue = 0;
+    }
+
+    void record(std::uint64_t v) {
+        ++counts[bucketOf(v)];
+        ++total;
+        sum += v;
+        if (v > maxValue) maxValue = v;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < kBuckets; ++i) counts[i] += other.counts[i];
+        total += other.total;
+        sum += other.sum;
+        if (other.maxValue > maxValue) maxValue = other.maxValue;
+    }
+
+    std::uint64_t count() const { return total; }
+    std::uint64_t max() const { return maxValue; }
+    double mean() const { return total ? static_cast<double>(sum) / total : 0.0; }
+
+    // Value at quantile q (0..1): midpoint of the bucket holding it, capped
+    // at the largest value recorded.
+    double percentile(double q) const {
+        if (total == 0) return 0.0;
+        std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            seen += counts[b];
+            if (seen >= rank) {
+                double mid = static_cast<double>(lowerBound(b)) + (width(b) - 1) / 2.0;
+                return mid > static_cast<double>(maxValue) ? static_cast<double>(maxValue) : mid;
+            }
+        }
+        return static_cast<double>(maxValue);
+    }
+
+    static int bucketOf(std::uint64_t v) {
+        if (v < static_cast<std::uint64_t>(kSub)) return static_cast<int>(v);
+        int msb = 63 - __builtin_clzll(v);
+        int shift = msb - kSubBits;
+        return (shift + 1) * kSub + static_cast<int>((v >> shift) & (kSub - 1));
+    }
+
+    static std::uint64_t lowerBound(int b) {
+        if (b < kSub) return static_cast<std::uint64_t>(b);
+        int shift = b / kSub - 1;
+        return static_cast<std::uint64_t>(kSub + b % kSub) << shift;
+    }
+
+    static double width(int b) { return b < kSub ? 1.0 : static_cast<double>(1ULL << (b / kSub - 1)); }
+
+private:
+    std::uint64_t counts[kBuckets];
+    std::uint64_t total;
+    std::uint64_t sum;
+    std::uint64_t maxValue;
+};
+
+#endif
@@ -0,0 +1,165 @@
+/*
+ * LengthBench.cpp
+ *
+ * Per-step cost of ChatGPTPaid's and CopilotPaid's free-function lists as the
+ * list grows, counted two ways:
+ *
+ *   rewalk  bare Node* head; every step first calls length()/listLength(),
+ *           as both programs' main() loops did before they moved to List
+ *   header  the List {head, tail, size} overloads; size is read, and
+ *           positions at the end go through tail
+ *
+ * At each size N the list is filled to N and then run for a fixed number of
+ * steps that keep it at about N, under two workloads:
+ *
+ *   ends    push at the front, append at the back, delete the front
+ *   random  insert / delete at random positions (the driver workload)
+ *
+ * For `ends` the header version does no walking at all, so its ns/step should
+ * stay flat while rewalk grows with N. For `random` both grow, but header
+ * only walks as far as the chosen position instead of the whole list first.
+ * Both variants of a run must end with the same checksum.
+ *
+ * Build: g++ -std=c++17 -O2 -o LengthBench LengthBench.cpp
+ * Run:   ./LengthBench [--max N] [--steps S] [--seed S]
+ */
+
+#include "ListAdapters.h"
+
+enum Workload { WL_ENDS, WL_RANDOM };
+
+// One step: grow or shrink with equal odds (always grow when empty).
+struct Step {
+    bool grow;
+    unsigned int r; // position / value source
+};
+
+static Step nextStep(std::mt19937& rng) {
+    unsigned int r = rng();
+    return {(r & 1) != 0, r >> 1};
+}
+
+/* ─── ChatGPTPaid ─────────────────────────────────────────────────── */
+
+static void chatgptRewalk(chatgpt_paid::Node*& head, Workload wl, const Step& s) {
+    int len = chatgpt_paid::length(head);
+    int value = static_cast<int>(s.r % 200001) - 100000;
+    if (s.grow || len == 0) {
+        if (wl == WL_RANDOM) chatgpt_paid::insert_at(head, static_cast<int>(s.r % (len + 1)), value);
+        else if (s.r & 2) chatgpt_paid::push_front(head, value);
+        else chatgpt_paid::insert_at(head, len, value);
+    } else {
+        chatgpt_paid::delete_at(head, wl == WL_RANDOM ? static_cast<int>(s.r % len) : 0);
+    }
+}
+
+static void chatgptHeader(chatgpt_paid::List& list, Workload wl, const Step& s) {
+    int len = list.size;
+    int value = static_cast<int>(s.r % 200001) - 100000;
+    if (s.grow || len == 0) {
+        if (wl == WL_RANDOM) chatgpt_paid::insert_at(list, static_cast<int>(s.r % (len + 1)), value);
+        else if (s.r & 2) chatgpt_paid::push_front(list, value);
+        else chatgpt_paid::insert_at(list, len, value);
+    } else {
+        chatgpt_paid::delete_at(list, wl == WL_RANDOM ? static_cast<int>(s.r % len) : 0);
+    }
+}
+
+/* ─── CopilotPaid ─────────────────────────────────────────────────── */
+
+static void copilotRewalk(copilot_paid::Node*& head, Workload wl, const Step& s) {
+    int len = copilot_paid::listLength(head);
+    int value = static_cast<int>(s.r % 200001) - 100000;
+    if (s.grow || len == 0) {
+        if (wl == WL_RANDOM) copilot_paid::insertAt(head, static_cast<int>(s.r % (len + 1)), value);
+        else if (s.r & 2) copilot_paid::pushFront(head, value);
+        else copilot_paid::insertAt(head, len, value);
+    } else {
+        copilot_paid::deleteAt(head, wl == WL_RANDOM ? static_cast<int>(s.r % len) : 0);
+    }
+}
+
+static void copilotHeader(copilot_paid::List& list, Workload wl, const Step& s) {
+    int len = list.size;
+    int value = static_cast<int>(s.r % 200001) - 100000;
+    if (s.grow || len == 0) {
+        if (wl == WL_RANDOM) copilot_paid::insertAt(list, static_cast<int>(s.r % (len + 1)), value);
+        else if (s.r & 2) copilot_paid::pushFront(list, value);
+        else copilot_paid::insertAt(list, len, value);
+    } else {
+        copilot_paid::deleteAt(list, wl == WL_RANDOM ? static_cast<int>(s.r % len) : 0);
+    }
+}
+
+/* ─── Timing ──────────────────────────────────────────────────────── */
+
+struct Timed {
+    double nsPerStep;
+    unsigned long long checksum;
+};
+
+// Fills to n with front pushes, then times `steps` balanced steps.
+template <typename L, typename StepFn, typename SumFn>
+static Timed timeRun(L& list, int n, long long steps, Workload wl, unsigned int seed,
+                     StepFn&& step, SumFn&& sum) {
+    std::mt19937 rng(seed);
+    for (int i = 0; i < n; ++i) step(list, WL_ENDS, Step{true, (static_cast<unsigned int>(i) << 2) | 2});
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < steps; ++i) step(list, wl, nextStep(rng));
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return {secs * 1e9 / steps, sum(list)};
+}
+
+int main(int argc, char** argv) {
+    int maxN = 32768;
+    long long steps = 5000;
+    unsigned int seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--max") == 0) maxN = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--steps") == 0) steps = std::atoll(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        else {
+            std::fprintf(stderr, "Usage: %s [--max N] [--steps S] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (steps < 1) steps = 1;
+
+    bool ok = true;
+    const char* wlNames[] = {"ends", "random"};
+    std::printf("%-12s %-7s %8s %14s %14s %8s\n", "list", "mix", "N", "rewalk ns/op", "header ns/op", "speedup");
+    for (int w = 0; w < 2; ++w) {
+        Workload wl = static_cast<Workload>(w);
+        for (int n = 1024; n <= maxN; n *= 2) {
+            {
+                chatgpt_paid::Node* head = nullptr;
+                chatgpt_paid::List list;
+                Timed a = timeRun(head, n, steps, wl, seed, chatgptRewalk,
+                                  [](chatgpt_paid::Node* h) { return chainChecksum(h, &chatgpt_paid::Node::value); });
+                Timed b = timeRun(list, n, steps, wl, seed, chatgptHeader,
+                                  [](chatgpt_paid::List& l) { return chainChecksum(l.head, &chatgpt_paid::Node::value); });
+                bool same = a.checksum == b.checksum;
+                ok = ok && same;
+                std::printf("%-12s %-7s %8d %14.0f %14.0f %7.1fx%s\n", "ChatGPTPaid", wlNames[w], n,
+                            a.nsPerStep, b.nsPerStep, a.nsPerStep / b.nsPerStep, same ? "" : "  CHECKSUM MISMATCH");
+                chatgpt_paid::free_list(head);
+                chatgpt_paid::free_list(list);
+            }
+            {
+                copilot_paid::Node* head = nullptr;
+                copilot_paid::List list;
+                Timed a = timeRun(head, n, steps, wl, seed, copilotRewalk,
+                                  [](copilot_paid::Node* h) { return chainChecksum(h, &copilot_paid::Node::value); });
+                Timed b = timeRun(list, n, steps, wl, seed, copilotHeader,
+                                  [](copilot_paid::List& l) { return chainChecksum(l.head, &copilot_paid::Node::value); });
+                bool same = a.checksum == b.checksum;
+                ok = ok && same;
+                std::printf("%-12s %-7s %8d %14.0f %14.0f %7.1fx%s\n", "CopilotPaid", wlNames[w], n,
+                            a.nsPerStep, b.nsPerStep, a.nsPerStep / b.nsPerStep, same ? "" : "  CHECKSUM MISMATCH");
+                copilot_paid::clearList(head);
+                copilot_paid::clearList(list);
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,400 @@
+/*
+ * LinkLayouts.cpp
+ *
+ * Doubly linked and XOR-linked versions of the CWE-478 list, benchmarked
+ * against ChatGPTFree's singly linked SinglyLinkedList.
+ *
+ * With only `next`, every positional operation walks from the head, and
+ * moveNode() walks from the head again to reach the destination, even when
+ * the destination is just behind the node that was moved. The two variants
+ * here can walk in both directions:
+ *
+ *   DoublyLinkedList  {data, prev, next}; a lookup starts from whichever of
+ *                     head, tail or a known node is closest to the index,
+ *                     and a found node unlinks in O(1)
+ *   XorLinkedList     {data, prev ^ next}; the same walks with one link word
+ *                     per node, using a (prev, cur) cursor that can step
+ *                     either way
+ *
+ * All three share ChatGPTFree's interface and moveNode() semantics (the
+ * destination indexes the list after the detach), so the same random op
+ * sequence must give the same checksum on each. The program checks that,
+ * then reports node size, heap bytes per node (from mallinfo2) and ns per
+ * positional operation at several sizes.
+ *
+ * Build: g++ -std=c++17 -O2 -o LinkLayouts LinkLayouts.cpp
+ * Run:   ./LinkLayouts [--ops N] [--seed S]
+ */
+
+#include "ListAdapters.h"
+
+#include <cstdint>
+#include <malloc.h>
+
+/* ─── Doubly linked ───────────────────────────────────────────────── */
+
+class DoublyLinkedList {
+private:
+    struct DNode {
+        int data;
+        DNode* prev;
+        DNode* next;
+    };
+
+    DNode* head;
+    DNode* tail;
+    int size;
+
+    // Node at `index` (0..size-1), walking from head, tail or `hint` (the
+    // node at `hintIndex`, if any), whichever is fewest links away.
+    DNode* locate(int index, DNode* hint = nullptr, int hintIndex = 0) const {
+        DNode* cur = head;
+        int at = 0;
+        if (size - 1 - index < index) {
+            cur = tail;
+            at = size - 1;
+        }
+        if (hint && std::abs(hintIndex - index) < std::abs(at - index)) {
+            cur = hint;
+            at = hintIndex;
+        }
+        while (at < index) { cur = cur->next; ++at; }
+        while (at > index) { cur = cur->prev; --at; }
+        return cur;
+    }
+
+    void unlink(DNode* n) {
+        if (n->prev) n->prev->next = n->next;
+        else head = n->next;
+        if (n->next) n->next->prev = n->prev;
+        else tail = n->prev;
+        --size;
+    }
+
+    // Links n in just before `at`, or at the end when `at` is null.
+    void linkBefore(DNode* at, DNode* n) {
+        n->next = at;
+        n->prev = at ? at->prev : tail;
+        if (n->prev) n->prev->next = n;
+        else head = n;
+        if (at) at->prev = n;
+        else tail = n;
+        ++size;
+    }
+
+public:
+    static const size_t nodeBytes = sizeof(DNode);
+
+    DoublyLinkedList() : head(nullptr), tail(nullptr), size(0) {}
+    ~DoublyLinkedList() { clear(); }
+
+    int getSize() const { return size; }
+
+    void clear() {
+        while (head) {
+            DNode* next = head->next;
+            delete head;
+            head = next;
+        }
+        tail = nullptr;
+        size = 0;
+    }
+
+    void pushBack(int value) { linkBefore(nullptr, new DNode{value, nullptr, nullptr}); }
+
+    void insertAt(int index, int value) {
+        if (index < 0) index = 0;
+        if (index > size) index = size;
+        DNode* at = index == size ? nullptr : locate(index);
+        linkBefore(at, new DNode{value, nullptr, nullptr});
+    }
+
+    void deleteAt(int index) {
+        if (index < 0 || index >= size) return;
+        DNode* doomed = locate(index);
+        unlink(doomed);
+        delete doomed;
+    }
+
+    void moveNode(int fromIndex, int toIndex) {
+        if (fromIndex < 0 || fromIndex >= size || toIndex < 0 || toIndex >= size || fromIndex == toIndex)
+            return;
+        DNode* moving = locate(fromIndex);
+        // After the unlink the old successor sits at fromIndex: a free
+        // starting point for short moves in either direction.
+        DNode* hint = moving->next;
+        int hintIndex = fromIndex;
+        if (!hint) {
+            hint = moving->prev;
+            hintIndex = fromIndex - 1;
+        }
+        unlink(moving);
+        DNode* at = toIndex == size ? nullptr : locate(toIndex, hint, hintIndex);
+        linkBefore(at, moving);
+    }
+
+    template <typename Fn>
+    void forEachValue(Fn fn) const {
+        for (DNode* cur = head; cur; cur = cur->next) fn(cur->data);
+    }
+};
+
+/* ─── XOR linked ──────────────────────────────────────────────────── */
+
+class XorLinkedList {
+private:
+    struct XNode {
+        int data;
+        std::uintptr_t link; // address of prev ^ address of next
+    };
+
+    static XNode* other(const XNode* n, const XNode* neighbour) {
+        return reinterpret_cast<XNode*>(n->link ^ reinterpret_cast<std::uintptr_t>(neighbour));
+    }
+    static std::uintptr_t bits(const XNode* n) { return reinterpret_cast<std::uintptr_t>(n); }
+
+    // A position between two nodes: `cur` is the node at `index` (null at
+    // the end), `prev` the one before it (null at the front). Holding both
+    // is what lets an XOR list step in either direction.
+    struct Cursor {
+        XNode* prev;
+        XNode* cur;
+        int index;
+
+        void forward() {
+            XNode* next = other(cur, prev);
+            prev = cur;
+            cur = next;
+            ++index;
+        }
+        void backward() {
+            XNode* before = other(prev, cur);
+            cur = prev;
+            prev = before;
+            --index;
+        }
+    };
+
+    XNode* head;
+    XNode* tail;
+    int size;
+
+    // Cursor at `index` (0..size) from the front, the back or `hint`.
+    Cursor seek(int index, const Cursor* hint = nullptr) const {
+        Cursor c = {nullptr, head, 0};
+        if (size - index < index) c = {tail, nullptr, size};
+        if (hint && std::abs(hint->index - index) < std::abs(c.index - index)) c = *hint;
+        while (c.index < index) c.forward();
+        while (c.index > index) c.backward();
+        return c;
+    }
+
+    // Unlinks c.cur; c is left at the same index, now holding the successor.
+    XNode* unlink(Cursor& c) {
+        XNode* n = c.cur;
+        XNode* next = other(n, c.prev);
+        if (c.prev) c.prev->link ^= bits(n) ^ bits(next);
+        else head = next;
+        if (next) next->link ^= bits(n) ^ bits(c.prev);
+        else tail = c.prev;
+        c.cur = next;
+        --size;
+        return n;
+    }
+
+    // Links n in between c.prev and c.cur, so it takes c.index.
+    void link(const Cursor& c, XNode* n) {
+        n->link = bits(c.prev) ^ bits(c.cur);
+        if (c.prev) c.prev->link ^= bits(c.cur) ^ bits(n);
+        else head = n;
+        if (c.cur) c.cur->link ^= bits(c.prev) ^ bits(n);
+        else tail = n;
+        ++size;
+    }
+
+public:
+    static const size_t nodeBytes = sizeof(XNode);
+
+    XorLinkedList() : head(nullptr), tail(nullptr), size(0) {}
+    ~XorLinkedList() { clear(); }
+
+    int getSize() const { return size; }
+
+    void clear() {
+        XNode* prev = nullptr;
+        XNode* cur = head;
+        while (cur) {
+            XNode* next = other(cur, prev);
+            delete prev;
+            prev = cur;
+            cur = next;
+        }
+        delete prev;
+        head = tail = nullptr;
+        size = 0;
+    }
+
+    void pushBack(int value) {
+        Cursor end = {tail, nullptr, size};
+        link(end, new XNode{value, 0});
+    }
+
+    void insertAt(int index, int value) {
+        if (index < 0) index = 0;
+        if (index > size) index = size;
+        link(seek(index), new XNode{value, 0});
+    }
+
+    void deleteAt(int index) {
+        if (index < 0 || index >= size) return;
+        Cursor c = seek(index);
+        delete unlink(c);
+    }
+
+    void moveNode(int fromIndex, int toIndex) {
+        if (fromIndex < 0 || fromIndex >= size || toIndex < 0 || toIndex >= size || fromIndex == toIndex)
+            return;
+        Cursor c = seek(fromIndex);
+        XNode* moving = unlink(c);
+        link(seek(toIndex, &c), moving);
+    }
+
+    template <typename Fn>
+    void forEachValue(Fn fn) const {
+        XNode* prev = nullptr;
+        for (XNode* cur = head; cur;) {
+            fn(cur->data);
+            XNode* next = other(cur, prev);
+            prev = cur;
+            cur = next;
+        }
+    }
+};
+
+/* ─── Benchmark ───────────────────────────────────────────────────── */
+
+enum OpKind { OK_INSERT, OK_DELETE, OK_MOVE, OK_MOVE_NEAR, OK_COUNT };
+static const char* const kOpNames[OK_COUNT] = {"insertAt", "deleteAt", "moveNode", "move +/-16"};
+
+// One operation's operands, drawn up front so every layout sees the same
+// sequence and the draws are not timed.
+struct PlannedOp {
+    int a;
+    int b;
+};
+
+// Plans `count` ops of one kind against a list that starts at n nodes.
+// Inserts and deletes alternate so the size stays at n or n + 1.
+static void planOps(std::mt19937& rng, OpKind kind, int n, PlannedOp* plan, int count) {
+    int size = n;
+    for (int i = 0; i < count; ++i) {
+        switch (kind) {
+            case OK_INSERT:
+            case OK_DELETE:
+                if (i % 2 == (kind == OK_INSERT ? 0 : 1)) {
+                    plan[i] = {static_cast<int>(rng() % (size + 1)), static_cast<int>(rng() % 1000)};
+                    ++size;
+                } else {
+                    plan[i] = {static_cast<int>(rng() % size), -1};
+                    --size;
+                }
+                break;
+            case OK_MOVE:
+                plan[i] = {static_cast<int>(rng() % size), static_cast<int>(rng() % size)};
+                break;
+            case OK_MOVE_NEAR: {
+                int from = static_cast<int>(rng() % size);
+                int to = from + static_cast<int>(rng() % 33) - 16;
+                plan[i] = {from, to < 0 ? 0 : (to >= size ? size - 1 : to)};
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+template <typename List>
+static void applyOps(List& list, OpKind kind, const PlannedOp* plan, int count) {
+    for (int i = 0; i < count; ++i) {
+        const PlannedOp& p = plan[i];
+        if (kind == OK_MOVE || kind == OK_MOVE_NEAR) list.moveNode(p.a, p.b);
+        else if (p.b >= 0) list.insertAt(p.a, p.b);
+        else list.deleteAt(p.a);
+    }
+}
+
+struct LayoutResult {
+    size_t nodeBytes;
+    double bytesPerNode;
+    double nsPerOp[OK_COUNT];
+    unsigned long long checksum;
+};
+
+template <typename List>
+static LayoutResult runLayout(size_t nodeBytes, int n, int opsPerKind, unsigned int seed, PlannedOp* plan) {
+    LayoutResult r;
+    r.nodeBytes = nodeBytes;
+    size_t before = mallinfo2().uordblks;
+    List* list = new List;
+    std::mt19937 fill(seed);
+    for (int i = 0; i < n; ++i) list->pushBack(static_cast<int>(fill() % 1000));
+    r.bytesPerNode = n > 0 ? static_cast<double>(mallinfo2().uordblks - before - sizeof(List)) / n : 0.0;
+
+    std::mt19937 rng(seed + 1);
+    for (int k = 0; k < OK_COUNT; ++k) {
+        planOps(rng, static_cast<OpKind>(k), list->getSize(), plan, opsPerKind);
+        auto start = std::chrono::steady_clock::now();
+        applyOps(*list, static_cast<OpKind>(k), plan, opsPerKind);
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        r.nsPerOp[k] = secs * 1e9 / opsPerKind;
+    }
+    r.checksum = listChecksum(*list);
+    delete list;
+    return r;
+}
+
+static void printRow(const char* layout, int n, const LayoutResult& r) {
+    std::printf("%-8s %8d %6zu %10.1f", layout, n, r.nodeBytes, r.bytesPerNode);
+    for (int k = 0; k < OK_COUNT; ++k) std::printf(" %12.0f", r.nsPerOp[k]);
+    std::printf("  %016llx\n", r.checksum);
+}
+
+int main(int argc, char** argv) {
+    int ops = 2000;
+    unsigned int seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--ops") == 0) ops = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        else {
+            std::fprintf(stderr, "Usage: %s [--ops N] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (ops < 2) ops = 2;
+
+    PlannedOp* plan = new PlannedOp[ops];
+    bool ok = true;
+    std::printf("%-8s %8s %6s %10s", "layout", "N", "sizeof", "heap/node");
+    for (int k = 0; k < OK_COUNT; ++k) std::printf(" %12s", kOpNames[k]);
+    std::printf("  checksum\n");
+
+    const int sizes[] = {1000, 10000, 100000};
+    for (int n : sizes) {
+        LayoutResult s = runLayout<chatgpt_free::SinglyLinkedList>(sizeof(chatgpt_free::Node), n, ops, seed, plan);
+        LayoutResult d = runLayout<DoublyLinkedList>(DoublyLinkedList::nodeBytes, n, ops, seed, plan);
+        LayoutResult x = runLayout<XorLinkedList>(XorLinkedList::nodeBytes, n, ops, seed, plan);
+        printRow("singly", n, s);
+        printRow("doubly", n, d);
+        printRow("xor", n, x);
+        if (d.checksum != s.checksum || x.checksum != s.checksum) {
+            std::printf("  checksum mismatch at N=%d\n", n);
+            ok = false;
+        }
+    }
+    std::printf("(ns per op; sizeof is the node struct, heap/node what malloc actually hands out per\n"
+                " node; glibc's 32-byte minimum chunk hides the XOR saving unless nodes are pooled)\n");
+
+    delete[] plan;
+    return ok ? 0 : 1;
+}
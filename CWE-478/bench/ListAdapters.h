@@ -0,0 +1,286 @@
+/*
+ * ListAdapters.h
+ *
+ * Pulls all eight CWE-478 programs into one translation unit, each in its own
+ * namespace with main() renamed, and wraps every list behind the same
+ * positional interface so bench tools can drive them identically:
+ *
+ *   insert(pos, value)  new value lands at index pos (0..size)
+ *   erase(pos)          removes index pos (0..size-1)
+ *   move(from, to)      unlinks index from and relinks it at index `to` of the
+ *                       list without it (0..size-1), the ChatGPTPaid convention
+ *   size(), checksum()  FNV-1a over the values in list order, the value
+ *                       Driver.cpp prints
+ *
+ * The adapters translate `to` into whatever each moveNode() expects; they do
+ * not paper over bugs in the programs themselves.
+ */
+
+#ifndef CWE478_LIST_ADAPTERS_H
+#define CWE478_LIST_ADAPTERS_H
+
+// Every header the programs use, so the re-includes inside the namespaces
+// below are no-ops.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define main chatgpt_free_main
+namespace chatgpt_free {
+#include "../code/ChatGPTFree.cpp"
+}
+#undef main
+
+#define main chatgpt_paid_main
+namespace chatgpt_paid {
+#include "../code/ChatGPTPaid.cpp"
+}
+#undef main
+
+#define main claude_free_main
+namespace claude_free {
+#include "../code/ClaudeFree.cpp"
+}
+#undef main
+
+#define main claude_paid_main
+namespace claude_paid {
+#include "../code/ClaudePaid.cpp"
+}
+#undef main
+
+#define main copilot_free_main
+namespace copilot_free {
+#include "../code/CopilotFree.cpp"
+}
+#undef main
+
+#define main copilot_paid_main
+namespace copilot_paid {
+#include "../code/CopilotPaid.cpp"
+}
+#undef main
+
+#define main gemini_free_main
+namespace gemini_free {
+#include "../code/GeminiFree.cpp"
+}
+#undef main
+
+#define main gemini_paid_main
+namespace gemini_paid {
+#include "../code/GeminiPaid.cpp"
+}
+#undef main
+
+/* ─── Checksum ────────────────────────────────────────────────────── */
+
+// One value's step of FNV-1a. Values up to 4 bytes hash as an unsigned int;
+// wider payloads (ChatGPTFree's templated list) are folded in 8-byte words.
+// Taken by value: packed fields cannot bind to references.
+template <typename T>
+inline void checksumMix(unsigned long long& h, T v) {
+    if constexpr (std::is_integral<T>::value && sizeof(T) <= sizeof(unsigned int)) {
+        h ^= static_cast<unsigned int>(v);
+        h *= 1099511628211ULL;
+    } else {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &v, sizeof(T));
+        for (size_t i = 0; i < sizeof(T); i += 8) {
+            unsigned long long word = 0;
+            std::memcpy(&word, bytes + i, sizeof(T) - i < 8 ? sizeof(T) - i : 8);
+            h ^= word;
+            h *= 1099511628211ULL;
+        }
+    }
+}
+
+const unsigned long long kChecksumSeed = 1469598103934665603ULL;
+
+// Any list that walks its own values with forEachValue(fn).
+template <typename List>
+unsigned long long listChecksum(const List& list) {
+    unsigned long long h = kChecksumSeed;
+    list.forEachValue([&h](auto v) { checksumMix(h, v); });
+    return h;
+}
+
+// A bare chain reached through a public head, hashing `field` of each node.
+template <typename Node, typename T>
+unsigned long long chainChecksum(const Node* head, T Node::*field) {
+    unsigned long long h = kChecksumSeed;
+    for (const Node* cur = head; cur; cur = cur->next) checksumMix(h, cur->*field);
+    return h;
+}
+
+/* ─── Adapters ────────────────────────────────────────────────────── */
+
+struct ChatGPTFreeAdapter {
+    static constexpr const char* name = "ChatGPTFree";
+    chatgpt_free::SinglyLinkedList list;
+
+    int size() const { return list.getSize(); }
+    void insert(int pos, int value) { list.insertAt(pos, value); }
+    void erase(int pos) { list.deleteAt(pos); }
+    void move(int from, int to) { list.moveNode(from, to); }
+    unsigned long long checksum() const { return listChecksum(list); }
+};
+
+struct ChatGPTPaidAdapter {
+    static constexpr const char* name = "ChatGPTPaid";
+    chatgpt_paid::List list; // header keeps size, so no length() walk
+
+    ~ChatGPTPaidAdapter() { chatgpt_paid::free_list(list); }
+
+    int size() const { return list.size; }
+    void insert(int pos, int value) { chatgpt_paid::insert_at(list, pos, value); }
+    void erase(int pos) { chatgpt_paid::delete_at(list, pos); }
+    void move(int from, int to) {
+        chatgpt_paid::insert_node_at(list, to, chatgpt_paid::detach_at(list, from));
+    }
+    unsigned long long checksum() const { return chainChecksum(list.head, &chatgpt_paid::Node::value); }
+};
+
+struct ClaudeFreeAdapter {
+    static constexpr const char* name = "ClaudeFree";
+    claude_free::LinkedList list;
+
+    int size() const { return list.size; }
+    void insert(int pos, int value) { list.insertAt(pos, value); }
+    void erase(int pos) { list.deleteAt(pos); }
+    void move(int from, int to) { list.moveAt(from, to); }
+    unsigned long long checksum() const { return chainChecksum(list.head, &claude_free::Node::data); }
+};
+
+struct ClaudePaidAdapter {
+    static constexpr const char* name = "ClaudePaid";
+    claude_paid::SinglyLinkedList list;
+
+    ClaudePaidAdapter() { list.setVerbose(false); }
+
+    int size() const { return list.getSize(); }
+    void insert(int pos, int value) { list.insertAt(pos, value); }
+    void erase(int pos) { list.deleteAt(pos); }
+    // moveNode() takes the index of the node to displace in the current list.
+    void move(int from, int to) { list.moveNode(from, to >= from ? to + 1 : to); }
+    unsigned long long checksum() const { return listChecksum(list); }
+};
+
+struct CopilotFreeAdapter {
+    static constexpr const char* name = "CopilotFree";
+    copilot_free::SinglyLinkedList list;
+
+    int size() { return list.getSize(); }
+    void insert(int pos, int value) { list.insertAt(pos, value); }
+    void erase(int pos) { list.removeAt(pos); }
+    void move(int from, int to) { list.moveNode(from, to); }
+    unsigned long long checksum() const { return listChecksum(list); }
+};
+
+struct CopilotPaidAdapter {
+    static constexpr const char* name = "CopilotPaid";
+    copilot_paid::List list;
+
+    ~CopilotPaidAdapter() { copilot_paid::clearList(list); }
+
+    int size() const { return list.size; }
+    void insert(int pos, int value) { copilot_paid::insertAt(list, pos, value); }
+    void erase(int pos) { copilot_paid::deleteAt(list, pos); }
+    // moveNode() takes an insertion point in the list before the unlink.
+    void move(int from, int to) { copilot_paid::moveNode(list, from, to >= from ? to + 1 : to); }
+    unsigned long long checksum() const { return chainChecksum(list.head, &copilot_paid::Node::value); }
+};
+
+struct GeminiFreeAdapter {
+    static constexpr const char* name = "GeminiFree";
+    gemini_free::LinkedList list;
+
+    int size() { return list.getSize(); }
+    void insert(int pos, int value) { list.insertAt(pos, value); }
+    void erase(int pos) { list.deleteAt(pos); }
+    void move(int from, int to) { list.moveNode(from, to); }
+    unsigned long long checksum() const { return listChecksum(list); }
+};
+
+struct GeminiPaidAdapter {
+    static constexpr const char* name = "GeminiPaid";
+    gemini_paid::SinglyLinkedList list;
+
+    int size() const { return list.getSize(); }
+    void insert(int pos, int value) { list.insertAt(pos, value); }
+    void erase(int pos) { list.deleteAt(pos); }
+    // moveNode() relinks after the node `to - 1` steps (or `to` steps when the
+    // source sat before it) from the head, so aim one slot early. It has no
+    // way to land a later node at index 1; those moves go to the front.
+    void move(int from, int to) {
+        if (to == 0 || to == from) list.moveNode(from, to);
+        else list.moveNode(from, from < to ? to : to - 1);
+    }
+    unsigned long long checksum() const { return listChecksum(list); }
+};
+
+static const char* const kAdapterNames[] = {
+    "ChatGPTFree", "ChatGPTPaid", "ClaudeFree", "ClaudePaid",
+    "CopilotFree", "CopilotPaid", "GeminiFree", "GeminiPaid",
+};
+static const int kAdapterCount = sizeof(kAdapterNames) / sizeof(kAdapterNames[0]);
+
+// Constructs the named adapter and hands it to fn. Returns false for an
+// unknown name.
+template <typename Fn>
+bool withAdapter(const char* name, Fn&& fn) {
+    if (std::strcmp(name, "ChatGPTFree") == 0) { ChatGPTFreeAdapter a; fn(a); return true; }
+    if (std::strcmp(name, "ChatGPTPaid") == 0) { ChatGPTPaidAdapter a; fn(a); return true; }
+    if (std::strcmp(name, "ClaudeFree") == 0)  { ClaudeFreeAdapter a;  fn(a); return true; }
+    if (std::strcmp(name, "ClaudePaid") == 0)  { ClaudePaidAdapter a;  fn(a); return true; }
+    if (std::strcmp(name, "CopilotFree") == 0) { CopilotFreeAdapter a; fn(a); return true; }
+    if (std::strcmp(name, "CopilotPaid") == 0) { CopilotPaidAdapter a; fn(a); return true; }
+    if (std::strcmp(name, "GeminiFree") == 0)  { GeminiFreeAdapter a;  fn(a); return true; }
+    if (std::strcmp(name, "GeminiPaid") == 0)  { GeminiPaidAdapter a;  fn(a); return true; }
+    return false;
+}
+
+// Runs fn in a forked child so one list corrupting the heap (CopilotFree's
+// moveNode() can) does not take the whole bench down. Returns true if the
+// child exited cleanly; otherwise prints how it died.
+template <typename Fn>
+bool runIsolated(const char* label, Fn&& fn) {
+    std::fflush(stdout);
+    std::fflush(stderr);
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        return false;
+    }
+    if (pid == 0) {
+        fn();
+        std::fflush(stdout);
+        _exit(0);
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0) {
+        std::perror("waitpid");
+        return false;
+    }
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0) return true;
+    if (WIFSIGNALED(status))
+        std::printf("%-12s crashed (%s)\n", label, strsignal(WTERMSIG(status)));
+    else
+        std::printf("%-12s exited with status %d\n", label, WEXITSTATUS(status));
+    return false;
+}
+
+#endif
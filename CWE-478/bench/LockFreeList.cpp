@@ -0,0 +1,492 @@
+/*
+ * LockFreeList.cpp
+ *
+ * A lock-free ordered singly linked list (Harris, with Michael's unlink-on-
+ * traversal) built from raw Node* links, next to a mutex-guarded version of
+ * ChatGPTFree's SinglyLinkedList.
+ *
+ *   - Deletion is two-step: the low bit of a node's `next` marks it logically
+ *     deleted, then a CAS on the predecessor's link unlinks it. Any traversal
+ *     that meets a marked node finishes the unlink.
+ *   - Unlinked nodes are retired to epoch-based reclamation: each thread
+ *     announces the global epoch while inside an operation, and a node
+ *     retired in epoch e is only deleted once the global epoch reaches e + 2,
+ *     when no thread can still be holding it.
+ *
+ * The program first runs a multi-threaded stress test and checks the final
+ * list against per-thread success counts, order, marks and allocation counts.
+ * It then benchmarks both lists at 1..16 threads on the same key range and
+ * op mix. The mutex baseline searches with lowerBound() and then calls
+ * insertAt()/deleteAt(), so it walks the list twice per hit.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -o LockFreeList LockFreeList.cpp
+ * Run:   ./LockFreeList [--keys N] [--ms PER_RUN] [--max-threads T] [--seed S]
+ */
+
+#include "ListAdapters.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/* ─── Allocation accounting (checked by the stress test) ─────────── */
+
+static std::atomic<long long> gNodesAllocated{0};
+static std::atomic<long long> gNodesFreed{0};
+
+/* ─── Marked pointers ─────────────────────────────────────────────── */
+
+struct LfNode {
+    int key;
+    std::atomic<LfNode*> next;
+
+    LfNode(int k, LfNode* n) : key(k), next(n) { gNodesAllocated.fetch_add(1, std::memory_order_relaxed); }
+    ~LfNode() { gNodesFreed.fetch_add(1, std::memory_order_relaxed); }
+};
+
+static bool isMarked(LfNode* p) { return (reinterpret_cast<std::uintptr_t>(p) & 1) != 0; }
+static LfNode* marked(LfNode* p) { return reinterpret_cast<LfNode*>(reinterpret_cast<std::uintptr_t>(p) | 1); }
+static LfNode* unmarked(LfNode* p) { return reinterpret_cast<LfNode*>(reinterpret_cast<std::uintptr_t>(p) & ~std::uintptr_t(1)); }
+
+/* ─── Epoch-based reclamation ─────────────────────────────────────── */
+
+class EpochDomain {
+public:
+    static const int kMaxThreads = 64;
+
+    EpochDomain() : global(2) {
+        for (int i = 0; i < kMaxThreads; ++i) {
+            slots[i].state.store(0, std::memory_order_relaxed);
+            slots[i].inUse.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    int claimSlot() {
+        for (int i = 0; i < kMaxThreads; ++i) {
+            bool expected = false;
+            if (slots[i].inUse.compare_exchange_strong(expected, true)) return i;
+        }
+        return -1;
+    }
+
+    void releaseSlot(int slot) { slots[slot].inUse.store(false, std::memory_order_release); }
+
+    // state = (epoch << 1) | active. The fence orders the announcement before
+    // any list pointer the operation goes on to read.
+    void enter(int slot) {
+        unsigned e = global.load(std::memory_order_acquire);
+        slots[slot].state.store((e << 1) | 1u, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void leave(int slot) { slots[slot].state.store(0, std::memory_order_release); }
+
+    unsigned current() const { return global.load(std::memory_order_acquire); }
+
+    // Bumps the global epoch if every active thread has already announced it.
+    unsigned tryAdvance() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        unsigned e = global.load(std::memory_order_acquire);
+        for (int i = 0; i < kMaxThreads; ++i) {
+            unsigned s = slots[i].state.load(std::memory_order_acquire);
+            if ((s & 1u) && (s >> 1) != e) return e;
+        }
+        global.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+        return global.load(std::memory_order_acquire);
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<unsigned> state;
+        std::atomic<bool> inUse;
+    };
+
+    alignas(64) std::atomic<unsigned> global;
+    Slot slots[kMaxThreads];
+};
+
+// Per-thread state: the epoch slot plus nodes waiting to be freed, in the
+// order (and so epoch order) they were retired.
+class ThreadCtx {
+public:
+    static const int kScanEvery = 64;
+
+    explicit ThreadCtx(EpochDomain& d) : domain(d), slot(d.claimSlot()), count(0), cap(256) {
+        limbo = new Retired[cap];
+    }
+
+    // Only once no thread can still be inside an operation.
+    ~ThreadCtx() {
+        for (int i = 0; i < count; ++i) delete limbo[i].node;
+        delete[] limbo;
+        if (slot >= 0) domain.releaseSlot(slot);
+    }
+
+    void enter() { domain.enter(slot); }
+    void leave() { domain.leave(slot); }
+
+    void retire(LfNode* node) {
+        if (count == cap) grow();
+        limbo[count].node = node;
+        limbo[count].epoch = domain.current();
+        if (++count % kScanEvery == 0) collect();
+    }
+
+    int pending() const { return count; }
+
+private:
+    struct Retired {
+        LfNode* node;
+        unsigned epoch;
+    };
+
+    void grow() {
+        Retired* bigger = new Retired[cap * 2];
+        std::memcpy(bigger, limbo, sizeof(Retired) * count);
+        delete[] limbo;
+        limbo = bigger;
+        cap *= 2;
+    }
+
+    void collect() {
+        unsigned g = domain.tryAdvance();
+        int freed = 0;
+        while (freed < count && limbo[freed].epoch + 2 <= g) delete limbo[freed++].node;
+        if (freed > 0) {
+            std::memmove(limbo, limbo + freed, sizeof(Retired) * (count - freed));
+            count -= freed;
+        }
+    }
+
+    EpochDomain& domain;
+    int slot;
+    Retired* limbo;
+    int count;
+    int cap;
+};
+
+/* ─── The list ────────────────────────────────────────────────────── */
+
+class LockFreeList {
+public:
+    LockFreeList() : head(nullptr) {}
+
+    // Only once no thread can still be inside an operation.
+    ~LockFreeList() {
+        LfNode* cur = unmarked(head.load());
+        while (cur) {
+            LfNode* next = unmarked(cur->next.load());
+            delete cur;
+            cur = next;
+        }
+    }
+
+    EpochDomain& epochs() { return domain; }
+
+    bool insert(ThreadCtx& ctx, int key) {
+        ctx.enter();
+        LfNode* node = new LfNode(key, nullptr);
+        bool inserted = false;
+        for (;;) {
+            std::atomic<LfNode*>* prev;
+            LfNode* cur;
+            if (find(ctx, key, prev, cur)) {
+                delete node;
+                break;
+            }
+            node->next.store(cur, std::memory_order_relaxed);
+            if (prev->compare_exchange_strong(cur, node, std::memory_order_release, std::memory_order_relaxed)) {
+                inserted = true;
+                break;
+            }
+        }
+        ctx.leave();
+        return inserted;
+    }
+
+    bool remove(ThreadCtx& ctx, int key) {
+        ctx.enter();
+        bool removed = false;
+        for (;;) {
+            std::atomic<LfNode*>* prev;
+            LfNode* cur;
+            if (!find(ctx, key, prev, cur)) break;
+
+            LfNode* next = cur->next.load(std::memory_order_acquire);
+            if (isMarked(next)) continue;
+            if (!cur->next.compare_exchange_strong(next, marked(next), std::memory_order_acq_rel))
+                continue;
+
+            // Logically gone. Unlink it here or let find() finish the job.
+            removed = true;
+            LfNode* expected = cur;
+            if (prev->compare_exchange_strong(expected, next, std::memory_order_acq_rel))
+                ctx.retire(cur);
+            else
+                find(ctx, key, prev, cur);
+            break;
+        }
+        ctx.leave();
+        return removed;
+    }
+
+    bool contains(ThreadCtx& ctx, int key) {
+        ctx.enter();
+        LfNode* cur = head.load(std::memory_order_acquire);
+        while (cur && cur->key < key) cur = unmarked(cur->next.load(std::memory_order_acquire));
+        bool hit = cur && cur->key == key && !isMarked(cur->next.load(std::memory_order_acquire));
+        ctx.leave();
+        return hit;
+    }
+
+    // Quiescent-only walk for the stress test: counts nodes, nodes still
+    // marked, and order violations.
+    void audit(int& nodes, int& marks, int& disorder) const {
+        nodes = marks = disorder = 0;
+        LfNode* cur = head.load();
+        int last = 0;
+        while (cur) {
+            LfNode* next = cur->next.load();
+            if (isMarked(next)) ++marks;
+            if (nodes > 0 && cur->key <= last) ++disorder;
+            last = cur->key;
+            ++nodes;
+            cur = unmarked(next);
+        }
+    }
+
+private:
+    // Leaves *prev == cur, where cur is the first unmarked node with
+    // cur->key >= key (or null). Marked nodes on the way are unlinked and
+    // retired; if a link changes under us the search restarts from head.
+    bool find(ThreadCtx& ctx, int key, std::atomic<LfNode*>*& prev, LfNode*& cur) {
+    retry:
+        prev = &head;
+        cur = prev->load(std::memory_order_acquire);
+        while (cur) {
+            LfNode* next = cur->next.load(std::memory_order_acquire);
+            if (isMarked(next)) {
+                LfNode* expected = cur;
+                if (!prev->compare_exchange_strong(expected, unmarked(next), std::memory_order_acq_rel))
+                    goto retry;
+                ctx.retire(cur);
+                cur = unmarked(next);
+                continue;
+            }
+            if (cur->key >= key) return cur->key == key;
+            prev = &cur->next;
+            cur = next;
+        }
+        return false;
+    }
+
+    std::atomic<LfNode*> head;
+    EpochDomain domain;
+};
+
+/* ─── Mutex baseline around ChatGPTFree's class ───────────────────── */
+
+class GuardedSinglyLinkedList {
+public:
+    bool insert(int key) {
+        std::lock_guard<std::mutex> hold(lock);
+        bool found;
+        int pos = list.lowerBound(key, found);
+        if (found) return false;
+        list.insertAt(pos, key);
+        return true;
+    }
+
+    bool remove(int key) {
+        std::lock_guard<std::mutex> hold(lock);
+        bool found;
+        int pos = list.lowerBound(key, found);
+        if (!found) return false;
+        list.deleteAt(pos);
+        return true;
+    }
+
+    int size() {
+        std::lock_guard<std::mutex> hold(lock);
+        return list.getSize();
+    }
+
+private:
+    std::mutex lock;
+    chatgpt_free::SinglyLinkedList list;
+};
+
+/* ─── Shared workload pieces ──────────────────────────────────────── */
+
+// xorshift64*: cheap, per-thread, seedable.
+struct FastRng {
+    unsigned long long s;
+    explicit FastRng(unsigned long long seed) : s(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+    unsigned int next() {
+        s ^= s >> 12;
+        s ^= s << 25;
+        s ^= s >> 27;
+        return static_cast<unsigned int>((s * 2685821657736338717ULL) >> 32);
+    }
+};
+
+struct Options {
+    int keys = 1024;
+    int ms = 300;
+    int maxThreads = 16;
+    unsigned int seed = 1;
+    long long stressOps = 200000; // per thread
+};
+
+/* ─── Stress test ─────────────────────────────────────────────────── */
+
+static bool stressTest(const Options& opt, int threads) {
+    long long startAlloc = gNodesAllocated.load(), startFreed = gNodesFreed.load();
+    bool ok = true;
+    {
+        LockFreeList list;
+        ThreadCtx** ctx = new ThreadCtx*[threads];
+        int** net = new int*[threads]; // per thread: successful inserts - removes per key
+        std::thread* workers = new std::thread[threads];
+
+        for (int t = 0; t < threads; ++t) {
+            ctx[t] = new ThreadCtx(list.epochs());
+            net[t] = new int[opt.keys]();
+        }
+        for (int t = 0; t < threads; ++t) {
+            workers[t] = std::thread([&, t] {
+                FastRng rng(opt.seed * 1000003ULL + t);
+                for (long long i = 0; i < opt.stressOps; ++i) {
+                    int key = static_cast<int>(rng.next() % opt.keys);
+                    if (rng.next() & 1) {
+                        if (list.insert(*ctx[t], key)) ++net[t][key];
+                    } else {
+                        if (list.remove(*ctx[t], key)) --net[t][key];
+                    }
+                }
+            });
+        }
+        for (int t = 0; t < threads; ++t) workers[t].join();
+
+        ThreadCtx& check = *ctx[0];
+        int expected = 0, wrongKeys = 0;
+        for (int k = 0; k < opt.keys; ++k) {
+            int sum = 0;
+            for (int t = 0; t < threads; ++t) sum += net[t][k];
+            if (sum != 0 && sum != 1) ++wrongKeys;
+            if (list.contains(check, k) != (sum == 1)) ++wrongKeys;
+            expected += sum;
+        }
+        int nodes, marks, disorder;
+        list.audit(nodes, marks, disorder);
+        if (wrongKeys || marks || disorder || nodes != expected) ok = false;
+        std::printf("stress %2d threads: %d nodes (expected %d), %d bad keys, %d marked, %d out of order %s\n",
+                    threads, nodes, expected, wrongKeys, marks, disorder, ok ? "OK" : "FAILED");
+
+        for (int t = 0; t < threads; ++t) {
+            delete ctx[t];
+            delete[] net[t];
+        }
+        delete[] workers;
+        delete[] net;
+        delete[] ctx;
+    }
+    long long leaked = (gNodesAllocated.load() - startAlloc) - (gNodesFreed.load() - startFreed);
+    if (leaked != 0) {
+        std::printf("stress %2d threads: %lld nodes leaked\n", threads, leaked);
+        ok = false;
+    }
+    return ok;
+}
+
+/* ─── Throughput ──────────────────────────────────────────────────── */
+
+// Runs `threads` workers doing 50/50 insert/remove on random keys for opt.ms
+// milliseconds against a list prefilled with every other key.
+template <typename Setup, typename Op>
+static double measure(const Options& opt, int threads, Setup&& setup, Op&& op) {
+    std::atomic<bool> go{false}, stop{false};
+    std::atomic<long long> total{0};
+    std::thread* workers = new std::thread[threads];
+    setup();
+    for (int t = 0; t < threads; ++t) {
+        workers[t] = std::thread([&, t] {
+            FastRng rng(opt.seed * 7919ULL + t);
+            long long done = 0;
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            while (!stop.load(std::memory_order_relaxed)) {
+                int key = static_cast<int>(rng.next() % opt.keys);
+                op(t, key, (rng.next() & 1) != 0);
+                ++done;
+            }
+            total.fetch_add(done);
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::milliseconds(opt.ms));
+    stop.store(true);
+    for (int t = 0; t < threads; ++t) workers[t].join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    delete[] workers;
+    return total.load() / secs;
+}
+
+static void benchmark(const Options& opt) {
+    std::printf("\n%-8s %16s %16s %8s\n", "threads", "lock-free ops/s", "mutex ops/s", "ratio");
+    for (int threads = 1; threads <= opt.maxThreads; threads *= 2) {
+        double lockFree;
+        {
+            LockFreeList list;
+            ThreadCtx** ctx = new ThreadCtx*[threads];
+            for (int t = 0; t < threads; ++t) ctx[t] = new ThreadCtx(list.epochs());
+            lockFree = measure(
+                opt, threads,
+                [&] { for (int k = 0; k < opt.keys; k += 2) list.insert(*ctx[0], k); },
+                [&](int t, int key, bool ins) {
+                    if (ins) list.insert(*ctx[t], key);
+                    else list.remove(*ctx[t], key);
+                });
+            for (int t = 0; t < threads; ++t) delete ctx[t];
+            delete[] ctx;
+        }
+        double guarded;
+        {
+            GuardedSinglyLinkedList list;
+            guarded = measure(
+                opt, threads,
+                [&] { for (int k = 0; k < opt.keys; k += 2) list.insert(k); },
+                [&](int, int key, bool ins) {
+                    if (ins) list.insert(key);
+                    else list.remove(key);
+                });
+        }
+        std::printf("%-8d %16.0f %16.0f %7.2fx\n", threads, lockFree, guarded,
+                    guarded > 0 ? lockFree / guarded : 0.0);
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--keys") == 0) opt.keys = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--ms") == 0) opt.ms = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--max-threads") == 0) opt.maxThreads = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seed") == 0) opt.seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        else if (std::strcmp(argv[i], "--stress-ops") == 0) opt.stressOps = std::atoll(argv[i + 1]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--keys N] [--ms PER_RUN] [--max-threads T] [--seed S] [--stress-ops N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (opt.keys < 2 || opt.maxThreads < 1 || opt.maxThreads > EpochDomain::kMaxThreads) {
+        std::fprintf(stderr, "need --keys >= 2 and 1 <= --max-threads <= %d\n", EpochDomain::kMaxThreads);
+        return 2;
+    }
+
+    bool ok = true;
+    for (int threads = 1; threads <= opt.maxThreads; threads *= 2) ok = stressTest(opt, threads) && ok;
+    benchmark(opt);
+    return ok ? 0 : 1;
+}
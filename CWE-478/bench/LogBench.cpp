@@ -0,0 +1,287 @@
+/*
+ * LogBench.cpp
+ *
+ * Cost of ClaudePaid's per-operation trace lines, via the original iostream
+ * path and via OpLog (OpLog.h).
+ *
+ * One seeded workload (the list held near --size nodes, so the walks stay
+ * short and the logging dominates) is run with:
+ *
+ *   silent          verbose off: the floor
+ *   iostream        the original std::cout lines, stdout redirected to a file
+ *   text            OpLog TEXT, flushed inline when the buffer fills
+ *   text-async      OpLog TEXT, background writer thread
+ *   binary          OpLog BINARY (17-byte records), inline
+ *   binary-async    OpLog BINARY, background writer thread
+ *
+ * After one untimed warm-up run, the modes are timed in --runs rounds
+ * (default 5) of one run each, so drift over time hits them all alike, and
+ * each mode reports its best run; logging ns/op is that minus silent's best,
+ * next to the spread of the silent runs as a noise floor.
+ *
+ * The text outputs must be byte-identical to the iostream one, and the
+ * binary log, re-rendered through OpLog TEXT, must be too.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -o LogBench LogBench.cpp
+ * Run:   ./LogBench [--ops N] [--size N] [--seed S] [--runs N] [--out PREFIX] [--keep]
+ */
+
+#include "ListAdapters.h"
+#include "OpLog.h"
+
+#include <fcntl.h>
+
+using claude_paid::SinglyLinkedList;
+
+// Feeds the list's trace hook into an OpLog.
+struct LogSink : claude_paid::OpSink {
+    OpLog& log;
+    explicit LogSink(OpLog& log) : log(log) {}
+    void addEnd(int val, int size) override { log.addEnd(val, size); }
+    void deleted(int val, int index, int size) override { log.deleted(val, index, size); }
+    void inserted(int val, int index, int size) override { log.inserted(val, index, size); }
+    void moved(int val, int from, int to, int size) override { log.moved(val, from, to, size); }
+    void compacted(int size) override { log.compacted(size); }
+};
+
+// Mix of the four operations that holds the list around `size` nodes.
+static void runWorkload(SinglyLinkedList& list, unsigned int seed, long long ops, int size) {
+    std::mt19937 rng(seed);
+    for (long long i = 0; i < ops; ++i) {
+        int n = list.getSize();
+        unsigned int r = rng();
+        int value = static_cast<int>(rng() % 1000);
+        if (n < 2 || (n < size && r % 2 == 0)) {
+            if (r & 2) list.addToEnd(value);
+            else list.insertAt(static_cast<int>(rng() % (n + 1)), value);
+        } else if (n >= size && r % 2 == 0) {
+            list.deleteAt(static_cast<int>(rng() % n));
+        } else {
+            int from = static_cast<int>(rng() % n);
+            list.moveNode(from, static_cast<int>(rng() % (n + 1)));
+        }
+    }
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static int openOut(const char* path) {
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) std::perror(path);
+    return fd;
+}
+
+static double runSilent(unsigned int seed, long long ops, int size) {
+    SinglyLinkedList list;
+    list.setVerbose(false);
+    auto start = std::chrono::steady_clock::now();
+    runWorkload(list, seed, ops, size);
+    return secondsSince(start);
+}
+
+// The original path: std::cout with fd 1 pointed at `path` for the run.
+static double runIostream(const char* path, unsigned int seed, long long ops, int size) {
+    int fd = openOut(path);
+    if (fd < 0) return -1;
+    std::cout.flush();
+    std::fflush(stdout);
+    int saved = ::dup(1);
+    ::dup2(fd, 1);
+    ::close(fd);
+
+    SinglyLinkedList list;
+    auto start = std::chrono::steady_clock::now();
+    runWorkload(list, seed, ops, size);
+    std::cout.flush();
+    std::fflush(stdout);
+    double secs = secondsSince(start);
+
+    ::dup2(saved, 1);
+    ::close(saved);
+    return secs;
+}
+
+static double runSink(const char* path, OpLog::Format format, bool async, unsigned int seed,
+                      long long ops, int size) {
+    std::FILE* out = std::fopen(path, "wb");
+    if (!out) {
+        std::perror(path);
+        return -1;
+    }
+    double secs;
+    {
+        OpLog log(out, format, async);
+        LogSink sink(log);
+        SinglyLinkedList list;
+        list.setLog(&sink);
+        auto start = std::chrono::steady_clock::now();
+        runWorkload(list, seed, ops, size);
+        log.flush();
+        secs = secondsSince(start);
+        list.setLog(nullptr);
+    }
+    std::fclose(out);
+    return secs;
+}
+
+// Re-renders a BINARY log as TEXT through OpLog itself.
+static bool renderBinary(const char* binPath, const char* textPath) {
+    std::FILE* in = std::fopen(binPath, "rb");
+    if (!in) {
+        std::perror(binPath);
+        return false;
+    }
+    char magic[8];
+    if (std::fread(magic, 1, 8, in) != 8 || std::memcmp(magic, "L478LOG1", 8) != 0) {
+        std::fclose(in);
+        return false;
+    }
+    std::FILE* text = std::fopen(textPath, "wb");
+    if (!text) {
+        std::perror(textPath);
+        std::fclose(in);
+        return false;
+    }
+    bool ok = true;
+    {
+        OpLog out(text, OpLog::TEXT, false);
+        unsigned char rec[OpLog::kRecordBytes];
+        while (std::fread(rec, 1, sizeof(rec), in) == sizeof(rec)) {
+            int f[4];
+            for (int i = 0; i < 4; ++i) {
+                const unsigned char* p = rec + 1 + 4 * i;
+                f[i] = static_cast<int>(p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<unsigned int>(p[3]) << 24));
+            }
+            switch (rec[0]) {
+                case OpLog::ADD_END: out.addEnd(f[0], f[3]); break;
+                case OpLog::DELETE:  out.deleted(f[0], f[1], f[3]); break;
+                case OpLog::INSERT:  out.inserted(f[0], f[1], f[3]); break;
+                case OpLog::MOVE:    out.moved(f[0], f[1], f[2], f[3]); break;
+                case OpLog::COMPACT: out.compacted(f[3]); break;
+                default: ok = false; break;
+            }
+        }
+        ok = ok && std::feof(in);
+    }
+    std::fclose(text);
+    std::fclose(in);
+    return ok;
+}
+
+static bool sameFile(const char* a, const char* b) {
+    std::FILE* fa = std::fopen(a, "rb");
+    std::FILE* fb = std::fopen(b, "rb");
+    bool same = fa && fb;
+    char ba[1 << 16], bb[1 << 16];
+    while (same) {
+        size_t na = std::fread(ba, 1, sizeof(ba), fa);
+        size_t nb = std::fread(bb, 1, sizeof(bb), fb);
+        if (na != nb || std::memcmp(ba, bb, na) != 0) same = false;
+        if (na == 0) break;
+    }
+    if (fa) std::fclose(fa);
+    if (fb) std::fclose(fb);
+    return same;
+}
+
+static long long fileSize(const char* path) {
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f) return -1;
+    std::fseek(f, 0, SEEK_END);
+    long long n = std::ftell(f);
+    std::fclose(f);
+    return n;
+}
+
+int main(int argc, char** argv) {
+    long long ops = 1000000;
+    int size = 100;
+    unsigned int seed = 1;
+    int runs = 5;
+    const char* prefix = "oplog";
+    bool keep = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--keep") == 0) {
+            keep = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Usage: %s [--ops N] [--size N] [--seed S] [--runs N] [--out PREFIX] [--keep]\n", argv[0]);
+            return 2;
+        }
+        if (std::strcmp(argv[i], "--ops") == 0) ops = std::atoll(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--size") == 0) size = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        else if (std::strcmp(argv[i], "--runs") == 0) runs = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--out") == 0) prefix = argv[i + 1];
+        else {
+            std::fprintf(stderr, "Usage: %s [--ops N] [--size N] [--seed S] [--runs N] [--out PREFIX] [--keep]\n", argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+    if (runs < 1) runs = 1;
+
+    const char* suffixes[] = {".iostream.txt", ".text.txt", ".text-async.txt", ".binary.bin",
+                              ".binary-async.bin", ".binary.txt"};
+    const int kFiles = sizeof(suffixes) / sizeof(suffixes[0]);
+    char paths[kFiles][512];
+    for (int i = 0; i < kFiles; ++i) std::snprintf(paths[i], sizeof(paths[i]), "%s%s", prefix, suffixes[i]);
+
+    struct Row {
+        const char* mode;
+        const char* path;
+        double secs; // best so far, -1 once a run fails
+    } rows[] = {
+        {"silent", nullptr, 1e30},      {"iostream", paths[0], 1e30}, {"text", paths[1], 1e30},
+        {"text-async", paths[2], 1e30}, {"binary", paths[3], 1e30},   {"binary-async", paths[4], 1e30},
+    };
+    const int kModes = sizeof(rows) / sizeof(rows[0]);
+    auto runMode = [&](int m) {
+        switch (m) {
+            case 0: return runSilent(seed, ops, size);
+            case 1: return runIostream(paths[0], seed, ops, size);
+            case 2: return runSink(paths[1], OpLog::TEXT, false, seed, ops, size);
+            case 3: return runSink(paths[2], OpLog::TEXT, true, seed, ops, size);
+            case 4: return runSink(paths[3], OpLog::BINARY, false, seed, ops, size);
+            default: return runSink(paths[4], OpLog::BINARY, true, seed, ops, size);
+        }
+    };
+
+    runMode(0); // warm-up: caches, allocator, clock speed
+    double silentWorst = 0;
+    for (int round = 0; round < runs; ++round) {
+        for (int m = 0; m < kModes; ++m) {
+            if (rows[m].secs < 0) continue;
+            double secs = runMode(m);
+            if (secs < 0 || secs < rows[m].secs) rows[m].secs = secs;
+            if (m == 0 && secs > silentWorst) silentWorst = secs;
+        }
+    }
+
+    std::printf("%lld ops on a ~%d-node ClaudePaid list, best of %d runs\n\n", ops, size, runs);
+    std::printf("%-14s %10s %12s %14s %12s\n", "mode", "secs", "ops/sec", "logging ns/op", "bytes");
+    bool ok = true;
+    for (const Row& r : rows) {
+        if (r.secs < 0) {
+            ok = false;
+            continue;
+        }
+        std::printf("%-14s %10.3f %12.0f %14.1f %12lld\n", r.mode, r.secs, ops / r.secs,
+                    (r.secs - rows[0].secs) * 1e9 / ops, r.path ? fileSize(r.path) : 0LL);
+    }
+    std::printf("(silent runs spread over %.1f ns/op; smaller differences are noise)\n",
+                (silentWorst - rows[0].secs) * 1e9 / ops);
+
+    bool textSame = sameFile(paths[0], paths[1]) && sameFile(paths[0], paths[2]);
+    bool binSame = sameFile(paths[3], paths[4]) && renderBinary(paths[3], paths[5]) && sameFile(paths[0], paths[5]);
+    std::printf("\ntext sinks match iostream output: %s\n", textSame ? "yes" : "NO");
+    std::printf("binary log renders to the same text: %s\n", binSame ? "yes" : "NO");
+    ok = ok && textSame && binSame;
+
+    if (!keep)
+        for (int i = 0; i < kFiles; ++i) std::remove(paths[i]);
+    return ok ? 0 : 1;
+}
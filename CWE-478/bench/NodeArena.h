@@ -0,0 +1,173 @@
+/*
+ * NodeArena.h
+ *
+ * Fixed-capacity storage for list nodes in one anonymous mapping, for lists
+ * big enough that page walks (TLB misses) dominate traversal. With huge
+ * pages requested the mapping is tried with MAP_HUGETLB (needs pages reserved
+ * in /proc/sys/vm/nr_hugepages), then as a 2 MiB-aligned region advised with
+ * MADV_HUGEPAGE (transparent huge pages), and otherwise stays on small pages.
+ * On a machine with more than one NUMA node the region is bound, preferred
+ * rather than strict, to the node of the CPU that created it; on one node
+ * that step is skipped. Off Linux the region is one plain heap block, with
+ * no huge-page or NUMA placement.
+ *
+ * Slots are raw storage of a fixed size, handed out from a free list of
+ * released slots, then from a bump pointer; a full arena returns nullptr.
+ * The caller constructs nodes in them. Not thread-safe.
+ *
+ * Header-only; knows nothing about the lists. HugePageBench.cpp plugs it into
+ * ClaudePaid's NodeSource hook.
+ */
+
+#ifndef CWE478_NODE_ARENA_H
+#define CWE478_NODE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class NodeArena {
+public:
+    enum Backing { SMALL_PAGES, TRANSPARENT_HUGE_PAGES, HUGETLB_PAGES };
+
+    // `slotBytes` is rounded up to hold the free-list link.
+    NodeArena(size_t slotBytes, size_t capacitySlots, bool hugePages)
+        : base(nullptr), bytes(0), slot(slotBytes < sizeof(void*) ? sizeof(void*) : slotBytes), capacity(0),
+          bumped(0), freeList(nullptr), backing(SMALL_PAGES), numaNode(-1) {
+        if (capacitySlots == 0) return;
+#ifdef __linux__
+        const size_t kHugePage = 2u << 20;
+        size_t want = capacitySlots * slot;
+        if (hugePages) {
+            bytes = (want + kHugePage - 1) & ~(kHugePage - 1);
+            void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                base = static_cast<char*>(p);
+                backing = HUGETLB_PAGES;
+            } else {
+                // Over-map by one huge page and trim, so the region starts on
+                // a 2 MiB boundary and THP can back all of it.
+                p = ::mmap(nullptr, bytes + kHugePage, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p != MAP_FAILED) {
+                    std::uintptr_t raw = reinterpret_cast<std::uintptr_t>(p);
+                    std::uintptr_t start = (raw + kHugePage - 1) & ~static_cast<std::uintptr_t>(kHugePage - 1);
+                    if (start > raw) ::munmap(p, start - raw);
+                    ::munmap(reinterpret_cast<char*>(start) + bytes, kHugePage - (start - raw));
+                    base = reinterpret_cast<char*>(start);
+                    if (!thpDisabled() && ::madvise(base, bytes, MADV_HUGEPAGE) == 0)
+                        backing = TRANSPARENT_HUGE_PAGES;
+                }
+            }
+        }
+        if (!base) {
+            bytes = want;
+            void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                bytes = 0;
+                return;
+            }
+            base = static_cast<char*>(p);
+        }
+        capacity = capacitySlots;
+        bindLocal();
+#else
+        (void)hugePages;
+        bytes = capacitySlots * slot;
+        base = static_cast<char*>(::operator new(bytes, std::nothrow));
+        if (!base) {
+            bytes = 0;
+            return;
+        }
+        capacity = capacitySlots;
+#endif
+    }
+
+    ~NodeArena() {
+#ifdef __linux__
+        if (base) ::munmap(base, bytes);
+#else
+        ::operator delete(base);
+#endif
+    }
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    void* allocate() {
+        void* p = freeList;
+        if (p)
+            std::memcpy(&freeList, p, sizeof(void*));
+        else if (bumped < capacity)
+            p = base + slot * bumped++;
+        return p;
+    }
+
+    void release(void* p) {
+        std::memcpy(p, &freeList, sizeof(void*));
+        freeList = p;
+    }
+
+    bool owns(const void* p) const {
+        std::uintptr_t x = reinterpret_cast<std::uintptr_t>(p);
+        std::uintptr_t lo = reinterpret_cast<std::uintptr_t>(base);
+        return base && x >= lo && x < lo + capacity * slot;
+    }
+
+    size_t getCapacity() const { return capacity; }
+    Backing getBacking() const { return backing; }
+    int getNumaNode() const { return numaNode; } // -1: not bound
+
+    static const char* backingName(Backing b) {
+        return b == HUGETLB_PAGES ? "hugetlb" : b == TRANSPARENT_HUGE_PAGES ? "thp" : "small-pages";
+    }
+
+private:
+#ifdef __linux__
+    static bool thpDisabled() {
+        char buf[128] = {0};
+        int fd = ::open("/sys/kernel/mm/transparent_hugepage/enabled", O_RDONLY);
+        if (fd < 0) return true;
+        ssize_t n = ::read(fd, buf, sizeof(buf) - 1);
+        ::close(fd);
+        return n <= 0 || std::strstr(buf, "[never]") != nullptr;
+    }
+
+    // mbind(MPOL_PREFERRED) to the current CPU's node, only when the system
+    // has more than one node online ("0" vs "0-1" or "0,2").
+    void bindLocal() {
+        char online[64] = {0};
+        int fd = ::open("/sys/devices/system/node/online", O_RDONLY);
+        if (fd < 0) return;
+        ssize_t n = ::read(fd, online, sizeof(online) - 1);
+        ::close(fd);
+        if (n <= 0 || (!std::strchr(online, '-') && !std::strchr(online, ','))) return;
+
+        unsigned int cpu = 0, node = 0;
+        if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0 || node >= 1024) return;
+        unsigned long mask[1024 / (8 * sizeof(unsigned long))] = {0};
+        mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+        const int kMpolPreferred = 1;
+        if (::syscall(SYS_mbind, base, bytes, kMpolPreferred, mask, 1024, 0) == 0)
+            numaNode = static_cast<int>(node);
+    }
+#endif
+
+    char* base;
+    size_t bytes;
+    size_t slot;     // bytes per slot
+    size_t capacity; // slots
+    size_t bumped;   // slots handed out by the bump pointer so far
+    void* freeList;
+    Backing backing;
+    int numaNode;
+};
+
+#endif
@@ -0,0 +1,267 @@
+/*
+ * OpLatency.cpp
+ *
+ * Per-operation latency of the CWE-478 lists, by operation type and by
+ * where in the list the operation lands.
+ *
+ * Each list is filled to N nodes (front inserts, untimed), then driven with
+ * a steady-state mix of the four operations the programs perform:
+ *
+ *   add_end  insert at index size
+ *   delete   erase at a random index
+ *   insert   insert at a random index
+ *   move     move between two random indices
+ *
+ * Every operation is timed with CycleClock into a LatencyHistogram for its
+ * type, and its ticks are also added to one of ten index bins (target index
+ * as a fraction of the size), so a positional walk shows up as a straight
+ * line from bin 0 to bin 9.
+ *
+ * Results go to stdout and, optionally, to a CSV file (one row per
+ * impl/op/metric) and a JSON Lines file (one object per impl). Each list runs
+ * in a forked child, which appends its own rows.
+ *
+ * Build: g++ -std=c++17 -O2 -o OpLatency OpLatency.cpp
+ * Run:   ./OpLatency [--impl NAME|all] [--nodes N] [--ops N] [--seed S]
+ *                    [--mix ADD,DEL,INS,MOVE] [--csv FILE] [--json FILE]
+ */
+
+#include "ListAdapters.h"
+#include "LatencyHistogram.h"
+
+enum OpType { OP_ADD_END, OP_DELETE, OP_INSERT, OP_MOVE, OP_TYPES };
+static const char* const kOpNames[OP_TYPES] = {"add_end", "delete", "insert", "move"};
+static const int kIndexBins = 10;
+
+struct Options {
+    const char* impl = "all";
+    int nodes = 10000;
+    long long ops = 20000;
+    unsigned int seed = 1;
+    // Weights for add-end, delete, insert, move. Deletes balance the two
+    // growing ops, so the size stays near N.
+    int mix[OP_TYPES] = {20, 40, 20, 20};
+    const char* csvPath = nullptr;
+    const char* jsonPath = nullptr;
+};
+
+struct OpStats {
+    LatencyHistogram hist;
+    std::uint64_t binTicks[kIndexBins];
+    std::uint64_t binCount[kIndexBins];
+
+    OpStats() {
+        std::memset(binTicks, 0, sizeof(binTicks));
+        std::memset(binCount, 0, sizeof(binCount));
+    }
+
+    void record(std::uint64_t ticks, int index, int size) {
+        hist.record(ticks);
+        int bin = size > 0 ? static_cast<int>(static_cast<long long>(index) * kIndexBins / (size + 1)) : 0;
+        binTicks[bin] += ticks;
+        ++binCount[bin];
+    }
+
+    double binMeanNs(int bin) const {
+        return binCount[bin] ? static_cast<double>(binTicks[bin]) / binCount[bin] * CycleClock::nsPerTick() : 0.0;
+    }
+};
+
+template <typename List>
+static void runWorkload(List& list, const Options& opt, OpStats* stats) {
+    std::mt19937 rng(opt.seed);
+    for (int i = 0; i < opt.nodes; ++i) list.insert(0, static_cast<int>(rng() % 1000));
+
+    const int total = opt.mix[0] + opt.mix[1] + opt.mix[2] + opt.mix[3];
+    for (long long i = 0; i < opt.ops; ++i) {
+        int size = list.size();
+        int roll = static_cast<int>(rng() % total);
+        int op = 0;
+        while (roll >= opt.mix[op]) roll -= opt.mix[op++];
+        if (size < 2) op = OP_ADD_END;
+
+        int a = static_cast<int>(rng() % (size + 1));
+        int b = static_cast<int>(rng() % (size + 1));
+        int value = static_cast<int>(rng() % 1000);
+        std::uint64_t t0, t1;
+        int index = a;
+        switch (op) {
+            case OP_ADD_END:
+                index = size;
+                t0 = CycleClock::now();
+                list.insert(size, value);
+                t1 = CycleClock::now();
+                break;
+            case OP_DELETE:
+                index = a % size;
+                t0 = CycleClock::now();
+                list.erase(index);
+                t1 = CycleClock::now();
+                break;
+            case OP_INSERT:
+                t0 = CycleClock::now();
+                list.insert(a, value);
+                t1 = CycleClock::now();
+                break;
+            default:
+                // Binned by the farther of the two indices, which bounds the walk.
+                a %= size;
+                b %= size;
+                index = a > b ? a : b;
+                t0 = CycleClock::now();
+                list.move(a, b);
+                t1 = CycleClock::now();
+                break;
+        }
+        stats[op].record(t1 - t0, index, size);
+    }
+}
+
+/* ─── Reporting ───────────────────────────────────────────────────── */
+
+static void printStats(const char* impl, const OpStats* stats) {
+    double ns = CycleClock::nsPerTick();
+    std::printf("%s\n  %-8s %9s %10s %10s %10s %10s %10s\n", impl, "op", "count", "mean ns", "p50 ns",
+                "p99 ns", "p999 ns", "max ns");
+    for (int op = 0; op < OP_TYPES; ++op) {
+        const LatencyHistogram& h = stats[op].hist;
+        std::printf("  %-8s %9llu %10.0f %10.0f %10.0f %10.0f %10.0f\n", kOpNames[op],
+                    static_cast<unsigned long long>(h.count()), h.mean() * ns, h.percentile(0.5) * ns,
+                    h.percentile(0.99) * ns, h.percentile(0.999) * ns, h.max() * ns);
+    }
+    std::printf("  mean ns by target index (tenths of the list):\n  %-8s", "op");
+    for (int bin = 0; bin < kIndexBins; ++bin) std::printf(" %8d", bin);
+    std::printf("\n");
+    for (int op = 0; op < OP_TYPES; ++op) {
+        std::printf("  %-8s", kOpNames[op]);
+        for (int bin = 0; bin < kIndexBins; ++bin) std::printf(" %8.0f", stats[op].binMeanNs(bin));
+        std::printf("\n");
+    }
+    std::printf("\n");
+}
+
+static void appendCsv(const char* path, const char* impl, const OpStats* stats) {
+    std::FILE* f = std::fopen(path, "a");
+    if (!f) {
+        std::perror(path);
+        return;
+    }
+    double ns = CycleClock::nsPerTick();
+    for (int op = 0; op < OP_TYPES; ++op) {
+        const LatencyHistogram& h = stats[op].hist;
+        const char* o = kOpNames[op];
+        std::fprintf(f, "%s,%s,count,%llu\n", impl, o, static_cast<unsigned long long>(h.count()));
+        std::fprintf(f, "%s,%s,mean_ns,%.1f\n", impl, o, h.mean() * ns);
+        std::fprintf(f, "%s,%s,p50_ns,%.1f\n", impl, o, h.percentile(0.5) * ns);
+        std::fprintf(f, "%s,%s,p99_ns,%.1f\n", impl, o, h.percentile(0.99) * ns);
+        std::fprintf(f, "%s,%s,p999_ns,%.1f\n", impl, o, h.percentile(0.999) * ns);
+        std::fprintf(f, "%s,%s,max_ns,%.1f\n", impl, o, h.max() * ns);
+        for (int bin = 0; bin < kIndexBins; ++bin)
+            std::fprintf(f, "%s,%s,index_bin_%d_mean_ns,%.1f\n", impl, o, bin, stats[op].binMeanNs(bin));
+    }
+    std::fclose(f);
+}
+
+static void appendJson(const char* path, const char* impl, const Options& opt, const OpStats* stats) {
+    std::FILE* f = std::fopen(path, "a");
+    if (!f) {
+        std::perror(path);
+        return;
+    }
+    double ns = CycleClock::nsPerTick();
+    std::fprintf(f, "{\"impl\":\"%s\",\"nodes\":%d,\"seed\":%u,\"ops\":{", impl, opt.nodes, opt.seed);
+    for (int op = 0; op < OP_TYPES; ++op) {
+        const LatencyHistogram& h = stats[op].hist;
+        std::fprintf(f, "%s\"%s\":{\"count\":%llu,\"mean_ns\":%.1f,\"p50_ns\":%.1f,\"p99_ns\":%.1f,"
+                        "\"p999_ns\":%.1f,\"max_ns\":%.1f,\"index_bin_mean_ns\":[",
+                     op ? "," : "", kOpNames[op], static_cast<unsigned long long>(h.count()), h.mean() * ns,
+                     h.percentile(0.5) * ns, h.percentile(0.99) * ns, h.percentile(0.999) * ns, h.max() * ns);
+        for (int bin = 0; bin < kIndexBins; ++bin)
+            std::fprintf(f, "%s%.1f", bin ? "," : "", stats[op].binMeanNs(bin));
+        std::fprintf(f, "]}");
+    }
+    std::fprintf(f, "}}\n");
+    std::fclose(f);
+}
+
+/* ─── Main ────────────────────────────────────────────────────────── */
+
+static void printUsage(const char* prog) {
+    std::fprintf(stderr,
+                 "Usage: %s [--impl NAME|all] [--nodes N] [--ops N] [--seed S]\n"
+                 "          [--mix ADD,DEL,INS,MOVE] [--csv FILE] [--json FILE]\n",
+                 prog);
+}
+
+static bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char* arg = argv[i];
+        const char* val = argv[i + 1];
+        if (std::strcmp(arg, "--impl") == 0) opt.impl = val;
+        else if (std::strcmp(arg, "--nodes") == 0) opt.nodes = std::atoi(val);
+        else if (std::strcmp(arg, "--ops") == 0) opt.ops = std::atoll(val);
+        else if (std::strcmp(arg, "--seed") == 0) opt.seed = static_cast<unsigned int>(std::strtoul(val, nullptr, 10));
+        else if (std::strcmp(arg, "--csv") == 0) opt.csvPath = val;
+        else if (std::strcmp(arg, "--json") == 0) opt.jsonPath = val;
+        else if (std::strcmp(arg, "--mix") == 0) {
+            if (std::sscanf(val, "%d,%d,%d,%d", &opt.mix[0], &opt.mix[1], &opt.mix[2], &opt.mix[3]) != 4)
+                return false;
+        } else {
+            return false;
+        }
+    }
+    if (argc % 2 == 0) return false;
+    int total = 0;
+    for (int w : opt.mix) {
+        if (w < 0) return false;
+        total += w;
+    }
+    return total > 0 && opt.nodes >= 0 && opt.ops > 0;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    bool all = std::strcmp(opt.impl, "all") == 0;
+    if (!all && !withAdapter(opt.impl, [](auto&) {})) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // Truncate the exports; each child appends its own rows.
+    if (opt.csvPath) {
+        std::FILE* f = std::fopen(opt.csvPath, "w");
+        if (!f) {
+            std::perror(opt.csvPath);
+            return 1;
+        }
+        std::fprintf(f, "impl,op,metric,value\n");
+        std::fclose(f);
+    }
+    if (opt.jsonPath) {
+        std::FILE* f = std::fopen(opt.jsonPath, "w");
+        if (!f) {
+            std::perror(opt.jsonPath);
+            return 1;
+        }
+        std::fclose(f);
+    }
+
+    std::printf("%d nodes, %lld timed ops, clock %.3f ns/tick\n\n", opt.nodes, opt.ops, CycleClock::nsPerTick());
+    for (int i = 0; i < kAdapterCount; ++i) {
+        const char* name = kAdapterNames[i];
+        if (!all && std::strcmp(opt.impl, name) != 0) continue;
+        runIsolated(name, [&] {
+            OpStats* stats = new OpStats[OP_TYPES];
+            withAdapter(name, [&](auto& list) { runWorkload(list, opt, stats); });
+            printStats(name, stats);
+            if (opt.csvPath) appendCsv(opt.csvPath, name, stats);
+            if (opt.jsonPath) appendJson(opt.jsonPath, name, opt, stats);
+            delete[] stats;
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * OpLog.h
+ *
+ * Buffered sink for the per-operation trace lines the CWE-478 lists print
+ * with std::cout. Lines are formatted by hand into a preallocated buffer and
+ * leave in large fwrite() calls on an unbuffered stream, either inline when
+ * the buffer fills or from a background writer thread that drains one buffer
+ * while the caller fills the other.
+ *
+ *   TEXT    byte-for-byte what ClaudePaid's iostream path prints
+ *   BINARY  the magic "L478LOG1", then fixed 17-byte records: kind (1 byte)
+ *           and four little-endian int32s (value, index, index2, size;
+ *           unused ones are 0)
+ *
+ * Header-only; knows nothing about the lists. LogBench.cpp plugs it into
+ * ClaudePaid's OpSink hook.
+ */
+
+#ifndef CWE478_OP_LOG_H
+#define CWE478_OP_LOG_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+class OpLog {
+public:
+    enum Format { TEXT, BINARY };
+    enum Kind : unsigned char { ADD_END = 1, DELETE, INSERT, MOVE, COMPACT };
+    static const int kRecordBytes = 17;
+
+    // `out` must be freshly opened; OpLog buffers itself and turns the
+    // stream's own buffering off.
+    OpLog(std::FILE* out, Format format, bool async, size_t bufferBytes = 1 << 20)
+        : out(out), format(format), async(async), capacity(bufferBytes), used(0), pending(0),
+          stopping(false) {
+        std::setvbuf(out, nullptr, _IONBF, 0);
+        active = new char[capacity];
+        spare = new char[capacity];
+        if (format == BINARY) put("L478LOG1", 8);
+        if (async) writer = std::thread(&OpLog::writerLoop, this);
+    }
+
+    ~OpLog() {
+        flush();
+        if (async) {
+            {
+                std::lock_guard<std::mutex> hold(lock);
+                stopping = true;
+            }
+            wake.notify_all();
+            writer.join();
+        }
+        delete[] active;
+        delete[] spare;
+    }
+
+    void addEnd(int val, int size) {
+        if (format == BINARY) return record(ADD_END, val, 0, 0, size);
+        put("  [ADD END] Added ");
+        putInt(val);
+        put(" at the end. Size: ");
+        putInt(size);
+        put("\n");
+    }
+
+    void deleted(int val, int index, int size) {
+        if (format == BINARY) return record(DELETE, val, index, 0, size);
+        put("  [DELETE]  Removed ");
+        putInt(val);
+        put(" at index ");
+        putInt(index);
+        put(". Size: ");
+        putInt(size);
+        put("\n");
+    }
+
+    void inserted(int val, int index, int size) {
+        if (format == BINARY) return record(INSERT, val, index, 0, size);
+        put("  [INSERT]  Inserted ");
+        putInt(val);
+        put(" at index ");
+        putInt(index);
+        put(". Size: ");
+        putInt(size);
+        put("\n");
+    }
+
+    void moved(int val, int fromIndex, int toIndex, int size) {
+        if (format == BINARY) return record(MOVE, val, fromIndex, toIndex, size);
+        put("  [MOVE]    Moved node with value ");
+        putInt(val);
+        put(" from index ");
+        putInt(fromIndex);
+        put(" to index ");
+        putInt(toIndex);
+        put(". Size: ");
+        putInt(size);
+        put("\n");
+    }
+
+    void compacted(int size) {
+        if (format == BINARY) return record(COMPACT, 0, 0, 0, size);
+        put("  [COMPACT] Relaid ");
+        putInt(size);
+        put(" nodes contiguously\n");
+    }
+
+    // Hands everything buffered so far to the kernel (async: waits for it).
+    void flush() {
+        if (used > 0) submit();
+        if (async) {
+            std::unique_lock<std::mutex> hold(lock);
+            wake.wait(hold, [this] { return pending == 0; });
+        }
+    }
+
+private:
+    void put(const char* text, size_t n) {
+        if (used + n > capacity) submit();
+        std::memcpy(active + used, text, n);
+        used += n;
+    }
+
+    template <size_t N>
+    void put(const char (&text)[N]) { put(text, N - 1); }
+
+    void putInt(int v) {
+        char digits[12];
+        int i = sizeof(digits);
+        unsigned int u = v < 0 ? 0u - static_cast<unsigned int>(v) : static_cast<unsigned int>(v);
+        do {
+            digits[--i] = static_cast<char>('0' + u % 10);
+            u /= 10;
+        } while (u);
+        if (v < 0) digits[--i] = '-';
+        put(digits + i, sizeof(digits) - i);
+    }
+
+    void record(Kind kind, int a, int b, int c, int d) {
+        char rec[kRecordBytes];
+        rec[0] = static_cast<char>(kind);
+        int fields[4] = {a, b, c, d};
+        for (int f = 0; f < 4; ++f) {
+            unsigned int u = static_cast<unsigned int>(fields[f]);
+            for (int byte = 0; byte < 4; ++byte) rec[1 + f * 4 + byte] = static_cast<char>(u >> (8 * byte));
+        }
+        put(rec, kRecordBytes);
+    }
+
+    static void writeAll(std::FILE* out, const char* data, size_t n) {
+        std::fwrite(data, 1, n, out); // nothing useful to do with a broken log
+    }
+
+    // Sync: write the active buffer now. Async: wait for the writer to finish
+    // the previous buffer, then swap and let it take this one.
+    void submit() {
+        if (!async) {
+            writeAll(out, active, used);
+            used = 0;
+            return;
+        }
+        std::unique_lock<std::mutex> hold(lock);
+        wake.wait(hold, [this] { return pending == 0; });
+        char* t = active;
+        active = spare;
+        spare = t;
+        pending = used;
+        used = 0;
+        hold.unlock();
+        wake.notify_all();
+    }
+
+    void writerLoop() {
+        std::unique_lock<std::mutex> hold(lock);
+        for (;;) {
+            wake.wait(hold, [this] { return pending > 0 || stopping; });
+            if (pending == 0) return;
+            size_t n = pending;
+            hold.unlock();
+            writeAll(out, spare, n);
+            hold.lock();
+            pending = 0;
+            wake.notify_all();
+        }
+    }
+
+    std::FILE* out;
+    Format format;
+    bool async;
+    size_t capacity;
+    char* active;   // being filled by the caller
+    char* spare;    // being written by the writer thread (async)
+    size_t used;
+    size_t pending; // bytes of `spare` still to be written; guarded by lock
+    bool stopping;
+    std::mutex lock;
+    std::condition_variable wake;
+    std::thread writer;
+};
+
+#endif
@@ -0,0 +1,160 @@
+/*
+ * OpTrace.h
+ *
+ * Compact binary trace of a CWE-478 list workload, written by Driver.cpp
+ * (--record) and read by TraceReplay.cpp.
+ *
+ * Layout: the 8-byte magic "L478TRC1", then one record per operation: the op
+ * code as one byte followed by its operands as LEB128 varints. Values are
+ * zigzag-encoded so small negatives stay short.
+ *
+ *   TRACE_ADD_FRONT  value
+ *   TRACE_DELETE     pos
+ *   TRACE_INSERT     pos value
+ *   TRACE_MOVE       from to      (`to` indexes the list after the detach)
+ *
+ * The codes are the values of ChatGPTPaid's Op enum (OP_ADD_FRONT ..
+ * OP_MOVE_NODE), the vocabulary this workload was first written in.
+ */
+
+#ifndef CWE478_OP_TRACE_H
+#define CWE478_OP_TRACE_H
+
+#include <cstdio>
+#include <cstring>
+
+enum TraceCode { TRACE_ADD_FRONT = 1, TRACE_DELETE, TRACE_INSERT, TRACE_MOVE };
+
+struct TraceOp {
+    TraceCode op;
+    int a; // value (add-front), pos (delete/insert) or from (move)
+    int b; // value (insert) or to (move); unused otherwise
+};
+
+static const char kTraceMagic[8] = {'L', '4', '7', '8', 'T', 'R', 'C', '1'};
+
+inline unsigned int traceZigzag(int v) {
+    return (static_cast<unsigned int>(v) << 1) ^ static_cast<unsigned int>(v >> 31);
+}
+
+inline int traceUnzigzag(unsigned int v) {
+    return static_cast<int>(v >> 1) ^ -static_cast<int>(v & 1);
+}
+
+inline void tracePutVarint(std::FILE* f, unsigned int v) {
+    while (v >= 0x80) {
+        std::fputc(static_cast<int>((v & 0x7F) | 0x80), f);
+        v >>= 7;
+    }
+    std::fputc(static_cast<int>(v), f);
+}
+
+inline bool traceGetVarint(std::FILE* f, unsigned int& v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        int c = std::fgetc(f);
+        if (c == EOF) return false;
+        v |= static_cast<unsigned int>(c & 0x7F) << shift;
+        if (!(c & 0x80)) return true;
+    }
+    return false;
+}
+
+// Creates `path` and writes the magic; nullptr if it cannot be opened.
+inline std::FILE* traceOpenWrite(const char* path) {
+    std::FILE* f = std::fopen(path, "wb");
+    if (f) std::fwrite(kTraceMagic, 1, sizeof(kTraceMagic), f);
+    return f;
+}
+
+inline void traceWrite(std::FILE* f, const TraceOp& t) {
+    std::fputc(static_cast<int>(t.op), f);
+    switch (t.op) {
+        case TRACE_ADD_FRONT:
+            tracePutVarint(f, traceZigzag(t.a));
+            break;
+        case TRACE_DELETE:
+            tracePutVarint(f, static_cast<unsigned int>(t.a));
+            break;
+        case TRACE_INSERT:
+            tracePutVarint(f, static_cast<unsigned int>(t.a));
+            tracePutVarint(f, traceZigzag(t.b));
+            break;
+        case TRACE_MOVE:
+            tracePutVarint(f, static_cast<unsigned int>(t.a));
+            tracePutVarint(f, static_cast<unsigned int>(t.b));
+            break;
+    }
+}
+
+inline bool traceRead(std::FILE* f, TraceOp& t) {
+    int code = std::fgetc(f);
+    if (code == EOF) return false;
+    unsigned int a = 0, b = 0;
+    t.op = static_cast<TraceCode>(code);
+    switch (t.op) {
+        case TRACE_ADD_FRONT:
+            if (!traceGetVarint(f, a)) return false;
+            t.a = traceUnzigzag(a);
+            t.b = 0;
+            return true;
+        case TRACE_DELETE:
+            if (!traceGetVarint(f, a)) return false;
+            t.a = static_cast<int>(a);
+            t.b = 0;
+            return true;
+        case TRACE_INSERT:
+            if (!traceGetVarint(f, a) || !traceGetVarint(f, b)) return false;
+            t.a = static_cast<int>(a);
+            t.b = traceUnzigzag(b);
+            return true;
+        case TRACE_MOVE:
+            if (!traceGetVarint(f, a) || !traceGetVarint(f, b)) return false;
+            t.a = static_cast<int>(a);
+            t.b = static_cast<int>(b);
+            return true;
+    }
+    return false;
+}
+
+// Reads the whole trace into a new[]-allocated array; returns the op count or
+// -1 on a bad file.
+inline long long loadTrace(const char* path, TraceOp*& ops) {
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        std::perror(path);
+        return -1;
+    }
+    char magic[sizeof(kTraceMagic)];
+    if (std::fread(magic, 1, sizeof(magic), f) != sizeof(magic) ||
+        std::memcmp(magic, kTraceMagic, sizeof(magic)) != 0) {
+        std::fprintf(stderr, "%s: not a CWE-478 trace\n", path);
+        std::fclose(f);
+        return -1;
+    }
+
+    long long count = 0, cap = 1 << 16;
+    ops = new TraceOp[cap];
+    TraceOp t;
+    while (traceRead(f, t)) {
+        if (count == cap) {
+            TraceOp* grown = new TraceOp[cap * 2];
+            std::memcpy(grown, ops, sizeof(TraceOp) * cap);
+            delete[] ops;
+            ops = grown;
+            cap *= 2;
+        }
+        ops[count++] = t;
+    }
+    bool clean = std::feof(f);
+    std::fclose(f);
+    if (!clean) {
+        std::fprintf(stderr, "%s: truncated record after %lld ops\n", path, count);
+        delete[] ops;
+        ops = nullptr;
+        return -1;
+    }
+    return count;
+}
+
+#endif
@@ -0,0 +1,190 @@
+/*
+ * ParallelBuild.cpp
+ *
+ * Speedup of ClaudePaid's appendBulk() and summarize() with thread count.
+ *
+ *   1. Correctness: a few thousand random single-node operations interleaved
+ *      with bulk appends, mirrored on a plain array; summarize() at several
+ *      thread counts must match a serial summary of the array each round
+ *      (exercising both the extend-the-skips and rebuild-the-skips paths).
+ *   2. Scaling: an N-node list (50M by default) is built from one value buffer
+ *      with appendBulk(), then reduced with summarize(), at each thread count.
+ *      Each result is checked against the buffer, and the list's FNV
+ *      listChecksum() against the buffer's.
+ *
+ * Speedups are relative to the single-thread run of the same code. On a
+ * machine with fewer cores than threads they flatten out (or drop) at the
+ * core count, and the build also contends on the allocator.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -o ParallelBuild ParallelBuild.cpp
+ * Run:   ./ParallelBuild [--nodes N] [--threads 1,4,8,16] [--skip K] [--seed S]
+ */
+
+#include "ListAdapters.h"
+
+using claude_paid::ListSummary;
+using claude_paid::SinglyLinkedList;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static ListSummary summarizeArray(const int* values, long long n) {
+    ListSummary s;
+    for (long long i = 0; i < n; ++i) s.add(values[i]);
+    return s;
+}
+
+static bool sameSummary(const ListSummary& a, const ListSummary& b) {
+    return a.count == b.count && a.sum == b.sum && a.min == b.min && a.max == b.max && a.hash == b.hash;
+}
+
+/* ─── Correctness ─────────────────────────────────────────────────── */
+
+static bool mirrorTest(unsigned int seed, int skip) {
+    const int kRounds = 200;
+    const int kCapacity = 1 << 20;
+    std::mt19937 rng(seed);
+    int* shadow = new int[kCapacity];
+    int* batch = new int[4096];
+    int n = 0;
+    SinglyLinkedList list;
+    list.setVerbose(false);
+    list.setSkipEvery(skip);
+    bool ok = true;
+
+    for (int round = 0; round < kRounds && ok; ++round) {
+        // A bulk append of up to 4K values...
+        int count = static_cast<int>(rng() % 4096);
+        if (n + count > kCapacity) count = 0;
+        for (int i = 0; i < count; ++i) batch[i] = static_cast<int>(rng() % 2001) - 1000;
+        list.appendBulk(batch, count, 1 + static_cast<int>(rng() % 8));
+        std::memcpy(shadow + n, batch, sizeof(int) * count);
+        n += count;
+
+        // ...then, every other round, a few single-node operations.
+        for (int k = 0; round % 2 == 1 && k < 8 && n > 1; ++k) {
+            int a = static_cast<int>(rng() % n);
+            int b = static_cast<int>(rng() % (n + 1));
+            int value = static_cast<int>(rng() % 1000);
+            switch (rng() % 3) {
+                case 0:
+                    list.insertAt(b, value);
+                    std::memmove(shadow + b + 1, shadow + b, sizeof(int) * (n - b));
+                    shadow[b] = value;
+                    ++n;
+                    break;
+                case 1:
+                    list.deleteAt(a);
+                    std::memmove(shadow + a, shadow + a + 1, sizeof(int) * (n - a - 1));
+                    --n;
+                    break;
+                default: {
+                    list.moveNode(a, b);
+                    int moved = shadow[a];
+                    std::memmove(shadow + a, shadow + a + 1, sizeof(int) * (n - a - 1));
+                    int to = b > a ? b - 1 : b;
+                    std::memmove(shadow + to + 1, shadow + to, sizeof(int) * (n - 1 - to));
+                    shadow[to] = moved;
+                    break;
+                }
+            }
+        }
+
+        ListSummary expected = summarizeArray(shadow, n);
+        for (int threads : {1, 3, 8}) {
+            if (!sameSummary(list.summarize(threads), expected)) {
+                std::printf("mirror: summarize(%d) mismatch in round %d (size %d)\n", threads, round, n);
+                ok = false;
+                break;
+            }
+        }
+    }
+    if (ok) std::printf("mirror: %d rounds, final size %d, skip %d: summaries match\n", kRounds, n, skip);
+    delete[] shadow;
+    delete[] batch;
+    return ok;
+}
+
+/* ─── Scaling ─────────────────────────────────────────────────────── */
+
+int main(int argc, char** argv) {
+    int nodes = 50000000;
+    int skip = 4096;
+    unsigned int seed = 1;
+    int threadCounts[16] = {1, 4, 8, 16};
+    int threadRuns = 4;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--nodes") == 0) nodes = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--skip") == 0) skip = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        else if (std::strcmp(argv[i], "--threads") == 0) {
+            threadRuns = 0;
+            for (const char* p = argv[i + 1]; *p && threadRuns < 16;) {
+                int t = std::atoi(p);
+                if (t > 0) threadCounts[threadRuns++] = t;
+                p = std::strchr(p, ',');
+                if (!p) break;
+                ++p;
+            }
+        } else {
+            std::fprintf(stderr, "Usage: %s [--nodes N] [--threads 1,4,8,16] [--skip K] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (nodes < 1 || skip < 1 || threadRuns == 0) {
+        std::fprintf(stderr, "Usage: %s [--nodes N] [--threads 1,4,8,16] [--skip K] [--seed S]\n", argv[0]);
+        return 2;
+    }
+
+    bool ok = mirrorTest(seed, 64);
+
+    std::mt19937 rng(seed);
+    int* values = new int[nodes];
+    for (int i = 0; i < nodes; ++i) values[i] = static_cast<int>(rng() % 1000);
+    ListSummary expected = summarizeArray(values, nodes);
+    unsigned long long fnv = 1469598103934665603ULL;
+    for (int i = 0; i < nodes; ++i) {
+        fnv ^= static_cast<unsigned int>(values[i]);
+        fnv *= 1099511628211ULL;
+    }
+
+    std::printf("\n%d nodes, skip pointers every %d (%u hardware threads)\n", nodes, skip,
+                std::thread::hardware_concurrency());
+    std::printf("%8s %12s %10s %12s %10s\n", "threads", "build s", "speedup", "reduce ms", "speedup");
+    double buildBase = 0, reduceBase = 0;
+    for (int r = 0; r < threadRuns; ++r) {
+        int threads = threadCounts[r];
+        SinglyLinkedList list;
+        list.setVerbose(false);
+        list.setSkipEvery(skip);
+
+        auto start = std::chrono::steady_clock::now();
+        list.appendBulk(values, nodes, threads);
+        double buildSecs = secondsSince(start);
+
+        // Best of three.
+        double reduceSecs = 1e9;
+        ListSummary got;
+        for (int rep = 0; rep < 3; ++rep) {
+            start = std::chrono::steady_clock::now();
+            got = list.summarize(threads);
+            double t = secondsSince(start);
+            if (t < reduceSecs) reduceSecs = t;
+        }
+
+        if (r == 0) {
+            buildBase = buildSecs;
+            reduceBase = reduceSecs;
+        }
+        std::printf("%8d %12.3f %9.2fx %12.1f %9.2fx\n", threads, buildSecs, buildBase / buildSecs,
+                    reduceSecs * 1e3, reduceBase / reduceSecs);
+        if (!sameSummary(got, expected) || listChecksum(list) != fnv) {
+            std::printf("  result mismatch at %d threads\n", threads);
+            ok = false;
+        }
+    }
+    std::printf("sum=%lld min=%d max=%d hash=%016llx\n", expected.sum, expected.min, expected.max, expected.hash);
+    delete[] values;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+/*
+ * PerfCounters.h
+ *
+ * Hardware event counts for the bench tools via perf_event_open(2), user
+ * space only (exclude_kernel), so it works at perf_event_paranoid <= 2.
+ *
+ *   PerfCounter c(PerfCounter::DTLB_LOAD_MISSES);
+ *   c.start(); ...; std::uint64_t misses = c.stop();
+ *
+ * When the event cannot be opened (no PMU in a VM, paranoid level, seccomp)
+ * available() is false and stop() returns 0; callers print "n/a".
+ *
+ * Header-only; Linux only.
+ */
+
+#ifndef CWE478_PERF_COUNTERS_H
+#define CWE478_PERF_COUNTERS_H
+
+#include <cstdint>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+class PerfCounter {
+public:
+    enum Event {
+        CYCLES,
+        INSTRUCTIONS,
+        CACHE_MISSES,       // generic "cache misses" (usually last-level)
+        L1D_LOAD_MISSES,
+        LLC_LOAD_MISSES,
+        DTLB_LOADS,
+        DTLB_LOAD_MISSES,
+    };
+
+    explicit PerfCounter(Event event) : fd(-1) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        configure(event, attr);
+        fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~PerfCounter() {
+        if (fd >= 0) ::close(fd);
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+        if (fd < 0) return;
+        ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    std::uint64_t stop() {
+        if (fd < 0) return 0;
+        ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t value = 0;
+        if (::read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) return 0;
+        return value;
+    }
+
+    static const char* name(Event event) {
+        switch (event) {
+            case CYCLES: return "cycles";
+            case INSTRUCTIONS: return "instructions";
+            case CACHE_MISSES: return "cache-misses";
+            case L1D_LOAD_MISSES: return "L1d-load-misses";
+            case LLC_LOAD_MISSES: return "LLC-load-misses";
+            case DTLB_LOADS: return "dTLB-loads";
+            case DTLB_LOAD_MISSES: return "dTLB-load-misses";
+        }
+        return "?";
+    }
+
+private:
+    static std::uint64_t cacheEvent(std::uint64_t cache, std::uint64_t result) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+    }
+
+    static void configure(Event event, perf_event_attr& attr) {
+        switch (event) {
+            case CYCLES:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case INSTRUCTIONS:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case CACHE_MISSES:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            case L1D_LOAD_MISSES:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS);
+                break;
+            case LLC_LOAD_MISSES:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cacheEvent(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_MISS);
+                break;
+            case DTLB_LOADS:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cacheEvent(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_RESULT_ACCESS);
+                break;
+            case DTLB_LOAD_MISSES:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cacheEvent(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_RESULT_MISS);
+                break;
+        }
+    }
+
+    int fd;
+};
+
+#endif
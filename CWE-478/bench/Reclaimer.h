@@ -0,0 +1,141 @@
+/*
+ * Reclaimer.h
+ *
+ * Deferred freeing of list nodes, for taking delete off an operation's path.
+ * Works with any node type that links through `next` and is freed with
+ * delete.
+ *
+ *   Reclaimer<Node>    frees chains of nodes on its own thread. handOff()
+ *                      only links the chain onto the pending one under the
+ *                      lock, so the caller pays O(1) per chain; the thread
+ *                      takes the whole pending chain and deletes it outside
+ *                      the lock.
+ *   RetireQueue<Node>  parks released nodes on a chain. Given a Reclaimer it
+ *                      hands the chain over every `batch` nodes; without one
+ *                      nothing is freed until the caller calls reclaim(), at
+ *                      a quiescent point of its choosing.
+ *
+ * Header-only. DeferredFree.cpp plugs RetireQueue into ClaudePaid's
+ * NodeSource hook.
+ */
+
+#ifndef CWE478_RECLAIMER_H
+#define CWE478_RECLAIMER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+template <typename Node>
+void freeNodeChain(Node* n) {
+    while (n) {
+        Node* next = n->next;
+        delete n;
+        n = next;
+    }
+}
+
+template <typename Node>
+class Reclaimer {
+public:
+    Reclaimer() : pending(nullptr), pendingTail(nullptr), stopping(false) {
+        worker = std::thread(&Reclaimer::run, this);
+    }
+
+    ~Reclaimer() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+        freeNodeChain(pending);
+    }
+
+    Reclaimer(const Reclaimer&) = delete;
+    Reclaimer& operator=(const Reclaimer&) = delete;
+
+    // Takes ownership of the chain first..last (linked through next).
+    void handOff(Node* first, Node* last) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (pendingTail) pendingTail->next = first;
+            else pending = first;
+            pendingTail = last;
+        }
+        wake.notify_one();
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;) {
+            wake.wait(guard, [this] { return pending || stopping; });
+            if (!pending) return;
+            Node* chain = pending;
+            pending = pendingTail = nullptr;
+            guard.unlock();
+            freeNodeChain(chain);
+            guard.lock();
+        }
+    }
+
+    Node* pending;
+    Node* pendingTail;
+    bool stopping;
+    std::mutex lock;
+    std::condition_variable wake;
+    std::thread worker;
+};
+
+template <typename Node>
+class RetireQueue {
+public:
+    // Frees only on reclaim().
+    RetireQueue() : RetireQueue(nullptr, 0) {}
+
+    // Hands every `batch` retired nodes to `reclaimer`, which must outlive
+    // the queue.
+    RetireQueue(Reclaimer<Node>& reclaimer, int batch) : RetireQueue(&reclaimer, batch > 0 ? batch : 1) {}
+
+    ~RetireQueue() { reclaim(); }
+
+    RetireQueue(const RetireQueue&) = delete;
+    RetireQueue& operator=(const RetireQueue&) = delete;
+
+    void retire(Node* n) {
+        n->next = nullptr;
+        if (tail) tail->next = n;
+        else head = n;
+        tail = n;
+        if (++count == batch) {
+            reclaimer->handOff(head, tail);
+            head = tail = nullptr;
+            count = 0;
+        }
+    }
+
+    int size() const { return count; }
+
+    // Frees every node retired and not yet handed off, on the calling thread;
+    // returns how many.
+    int reclaim() {
+        int freed = count;
+        freeNodeChain(head);
+        head = tail = nullptr;
+        count = 0;
+        return freed;
+    }
+
+private:
+    RetireQueue(Reclaimer<Node>* reclaimer, int batch)
+        : head(nullptr), tail(nullptr), count(0), batch(batch), reclaimer(reclaimer) {}
+
+    Node* head;
+    Node* tail;
+    int count;
+    int batch; // 0: no reclaimer
+    Reclaimer<Node>* reclaimer;
+};
+
+#endif
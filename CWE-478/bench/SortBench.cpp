@@ -0,0 +1,147 @@
+/*
+ * SortBench.cpp
+ *
+ * Checks and times ChatGPTPaid's bulk list helpers: sort_list() (bottom-up
+ * merge sort), dedupe_sorted() and splice_after().
+ *
+ *   1. Randomized check: lists of random length and value spread are sorted,
+ *      deduped and spliced, and each result is compared node by node with the
+ *      same operation done on a plain array.
+ *   2. Benchmark: sorts an N-node list of random values (1M by default) and
+ *      reports the time next to std::sort on an array of the same values.
+ *
+ * Exits non-zero if any result disagrees with the array.
+ *
+ * Build: g++ -std=c++17 -O2 -o SortBench SortBench.cpp
+ * Run:   ./SortBench [--nodes N] [--rounds R] [--seed S]
+ */
+
+#include "ListAdapters.h"
+
+#include <algorithm>
+
+using chatgpt_paid::Node;
+
+// Builds a list holding values[0..n) in order.
+static Node* buildList(const int* values, int n, Node*& tail) {
+    Node* head = nullptr;
+    tail = nullptr;
+    for (int i = n - 1; i >= 0; --i) {
+        chatgpt_paid::push_front(head, values[i]);
+        if (!tail) tail = head;
+    }
+    return head;
+}
+
+// True if the list holds exactly values[0..n).
+static bool sameAs(Node* head, const int* values, int n) {
+    for (int i = 0; i < n; ++i, head = head->next) {
+        if (!head || head->value != values[i]) return false;
+    }
+    return head == nullptr;
+}
+
+static bool checkRound(std::mt19937& rng, int round) {
+    int n = static_cast<int>(rng() % 3000);
+    int spread = 1 + static_cast<int>(rng() % (round % 2 ? 50 : 1000000));
+    int* ref = new int[n + 1];
+    for (int i = 0; i < n; ++i) ref[i] = static_cast<int>(rng() % spread) - spread / 2;
+
+    bool ok = true;
+    Node* tail;
+    Node* head = buildList(ref, n, tail);
+
+    // sort
+    tail = chatgpt_paid::sort_list(head);
+    std::sort(ref, ref + n);
+    if (!sameAs(head, ref, n) || (n > 0 && (!tail || tail->next || tail->value != ref[n - 1]))) {
+        std::printf("round %d: sort mismatch (n=%d)\n", round, n);
+        ok = false;
+    }
+
+    // dedupe
+    int dropped = chatgpt_paid::dedupe_sorted(head);
+    int unique = static_cast<int>(std::unique(ref, ref + n) - ref);
+    if (dropped != n - unique || !sameAs(head, ref, unique)) {
+        std::printf("round %d: dedupe mismatch (n=%d)\n", round, n);
+        ok = false;
+    }
+
+    // splice a second list in at a random position (or the front)
+    int m = static_cast<int>(rng() % 500);
+    int* other = new int[m + 1];
+    for (int i = 0; i < m; ++i) other[i] = static_cast<int>(rng() % 1000);
+    Node* otherTail;
+    Node* otherHead = buildList(other, m, otherTail);
+    int at = static_cast<int>(rng() % (unique + 1)); // splice after node at-1; 0 => front
+    Node* pos = at == 0 ? nullptr : chatgpt_paid::node_at(head, at - 1);
+    chatgpt_paid::splice_after(head, pos, otherHead, otherTail);
+
+    int* joined = new int[unique + m + 1];
+    std::memcpy(joined, ref, sizeof(int) * at);
+    std::memcpy(joined + at, other, sizeof(int) * m);
+    std::memcpy(joined + at + m, ref + at, sizeof(int) * (unique - at));
+    if (!sameAs(head, joined, unique + m)) {
+        std::printf("round %d: splice mismatch (n=%d m=%d at=%d)\n", round, unique, m, at);
+        ok = false;
+    }
+
+    chatgpt_paid::free_list(head);
+    delete[] joined;
+    delete[] other;
+    delete[] ref;
+    return ok;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int nodes = 1000000;
+    int rounds = 200;
+    unsigned int seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--nodes") == 0) nodes = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--rounds") == 0) rounds = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        else {
+            std::fprintf(stderr, "Usage: %s [--nodes N] [--rounds R] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::mt19937 rng(seed);
+    int failed = 0;
+    for (int r = 0; r < rounds; ++r) {
+        if (!checkRound(rng, r)) ++failed;
+    }
+    std::printf("randomized check: %d/%d rounds passed\n", rounds - failed, rounds);
+
+    int* values = new int[nodes > 0 ? nodes : 1];
+    for (int i = 0; i < nodes; ++i) values[i] = static_cast<int>(rng());
+
+    Node* tail;
+    Node* head = buildList(values, nodes, tail);
+    auto start = std::chrono::steady_clock::now();
+    chatgpt_paid::sort_list(head);
+    double listSecs = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    std::sort(values, values + nodes);
+    double arraySecs = secondsSince(start);
+
+    bool sorted = sameAs(head, values, nodes);
+    std::printf("sort %d nodes: list %.3fs, array std::sort %.3fs (%.1fx) %s\n", nodes, listSecs,
+                arraySecs, arraySecs > 0 ? listSecs / arraySecs : 0.0, sorted ? "OK" : "MISMATCH");
+
+    // Sorted input, but the nodes are now scattered in memory relative to list
+    // order, so every step of every pass is a likely cache miss.
+    start = std::chrono::steady_clock::now();
+    chatgpt_paid::sort_list(head);
+    std::printf("re-sort (sorted, scattered nodes): %.3fs\n", secondsSince(start));
+
+    chatgpt_paid::free_list(head);
+    delete[] values;
+    return (failed == 0 && sorted) ? 0 : 1;
+}
@@ -0,0 +1,336 @@
+/*
+ * TraceReplay.cpp
+ *
+ * Replays an operation trace recorded with `Driver --record FILE` (format in
+ * OpTrace.h) against the CWE-478 list implementations and reports replay
+ * throughput.
+ *
+ * Two engines are timed:
+ *   naive    applies each operation as it comes, through ListAdapters.h, so
+ *            any of the eight lists can be replayed
+ *   batched  works on ChatGPTPaid's raw Node* list and queues up to --batch
+ *            ops of every kind, resolving each position against the queue
+ *            instead of the list: an insert becomes an entry anchored to a
+ *            gap of the list, a delete or move of a queued entry edits the
+ *            queue, and a delete or move of a list node marks it gone. A
+ *            flush then applies the whole batch in one forward walk.
+ *
+ * Resolving a position scans the queue, so per-op cost grows with --batch
+ * while each flush saves up to --batch list walks. The default of 64 gives
+ * about 10x on the Driver's default mix at 3000 nodes and 30x at 20000; on
+ * lists of a few hundred nodes the walks are cheap and batching gains little
+ * or loses.
+ *
+ * Both must finish with the checksum the recording run printed.
+ *
+ * Build: g++ -std=c++17 -O2 -o TraceReplay TraceReplay.cpp
+ * Run:   ./TraceReplay TRACE_FILE [--impl NAME|all] [--batch N]
+ */
+
+#include "ListAdapters.h"
+#include "OpTrace.h"
+
+using chatgpt_paid::Node;
+
+/* ─── Engines ─────────────────────────────────────────────────────── */
+
+struct ReplayResult {
+    double secs;
+    int size;
+    unsigned long long checksum;
+};
+
+template <typename List>
+static ReplayResult replayNaive(List& list, const TraceOp* ops, long long count) {
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < count; ++i) {
+        const TraceOp& t = ops[i];
+        switch (t.op) {
+            case TRACE_ADD_FRONT: list.insert(0, t.a); break;
+            case TRACE_DELETE:    list.erase(t.a); break;
+            case TRACE_INSERT:    list.insert(t.a, t.b); break;
+            case TRACE_MOVE:      list.move(t.a, t.b); break;
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return {std::chrono::duration<double>(stop - start).count(), list.size(), list.checksum()};
+}
+
+// An insert or move waiting for the next flush, in list order. `anchor` is
+// the gap of the flushed list it lands in: before node `anchor`, after any
+// earlier entries with the same anchor. `base` is the flushed-list index of a
+// moved node, or -1 for a new value.
+struct PendingEntry {
+    int anchor;
+    int value;
+    int base;
+};
+
+// A flushed-list node that is deleted or moved away. `node` and `stand` are
+// only used during the flush: the detached node once it has been passed, or
+// the stand-in linked where it lands if that comes first.
+struct GoneNode {
+    int base;
+    bool moved;
+    Node* node;
+    Node* stand;
+};
+
+// Where an index of the pending list falls: on queued entry `entry`, or on
+// flushed-list node `base` (entry == -1; both -1 one past the end). `at` and
+// `anchor` say where an entry inserted at that index goes.
+struct Slot {
+    int entry;
+    int base;
+    int at;
+    int anchor;
+};
+
+class BatchedReplayer {
+public:
+    Node* head;
+    int len;              // length with the queued ops applied
+    long long batches;    // flushes
+    long long batchedOps; // ops applied through flushes
+
+    explicit BatchedReplayer(int batchLimit)
+        : head(nullptr), len(0), batches(0), batchedOps(0), limit(batchLimit), queued(0),
+          baseLen(0), entryCount(0), goneCount(0), entries(new PendingEntry[batchLimit]),
+          gone(new GoneNode[batchLimit]) {}
+
+    ~BatchedReplayer() {
+        chatgpt_paid::free_list(head);
+        delete[] entries;
+        delete[] gone;
+    }
+
+    void apply(const TraceOp& t) {
+        switch (t.op) {
+            case TRACE_ADD_FRONT:
+                insert(0, {0, t.a, -1});
+                break;
+            case TRACE_INSERT:
+                insert(t.a, {0, t.b, -1});
+                break;
+            case TRACE_DELETE: {
+                Slot s = locate(t.a);
+                if (s.entry < 0) {
+                    addGone(s.base, false);
+                } else {
+                    if (entries[s.entry].base >= 0) findGone(entries[s.entry].base).moved = false;
+                    eraseEntry(s.entry);
+                }
+                --len;
+                break;
+            }
+            case TRACE_MOVE: {
+                Slot s = locate(t.a);
+                PendingEntry e = {0, 0, s.base};
+                if (s.entry < 0) {
+                    addGone(s.base, true);
+                } else {
+                    e = entries[s.entry];
+                    eraseEntry(s.entry);
+                }
+                --len;
+                insert(t.b, e);
+                break;
+            }
+        }
+        if (++queued == limit) flush();
+    }
+
+    // One forward walk over the flushed list: queued entries are linked in at
+    // their anchors and gone nodes are unlinked as they are passed. The walk
+    // stops after the last anchor or gone node.
+    void flush() {
+        if (queued == 0) return;
+        Node** link = &head;
+        int g = 0, i = 0, j = 0;
+        while (i < entryCount || j < goneCount) {
+            for (; i < entryCount && entries[i].anchor == g; ++i) link = emit(link, entries[i]);
+            if (j == goneCount) {
+                if (i == entryCount) break;
+            } else if (gone[j].base == g) {
+                Node* n = *link;
+                *link = n->next;
+                GoneNode& d = gone[j++];
+                if (!d.moved) {
+                    delete n;
+                } else if (d.stand) {
+                    d.stand->value = n->value;
+                    delete n;
+                } else {
+                    d.node = n;
+                }
+                ++g;
+                continue;
+            }
+            link = &(*link)->next;
+            ++g;
+        }
+        baseLen = len;
+        ++batches;
+        batchedOps += queued;
+        queued = entryCount = goneCount = 0;
+    }
+
+private:
+    // Scans the entries and gone nodes in step, counting the surviving
+    // flushed-list nodes between anchors, until index `v` is reached.
+    Slot locate(int v) const {
+        int g = 0, seen = 0, i = 0, j = 0;
+        for (;;) {
+            int a = (i < entryCount) ? entries[i].anchor : baseLen;
+            int jEnd = j;
+            while (jEnd < goneCount && gone[jEnd].base < a) ++jEnd;
+            int run = (a - g) - (jEnd - j);
+            if (v < seen + run) {
+                int k = g + (v - seen);
+                for (; j < jEnd && gone[j].base <= k; ++j) ++k;
+                return {-1, k, i, k};
+            }
+            seen += run;
+            g = a;
+            j = jEnd;
+            if (i == entryCount) return {-1, -1, i, baseLen};
+            if (v == seen) return {i, -1, i, entries[i].anchor};
+            ++seen;
+            ++i;
+        }
+    }
+
+    void insert(int pos, PendingEntry e) {
+        Slot s = locate(pos);
+        e.anchor = s.anchor;
+        std::memmove(&entries[s.at + 1], &entries[s.at], sizeof(PendingEntry) * (entryCount - s.at));
+        entries[s.at] = e;
+        ++entryCount;
+        ++len;
+    }
+
+    void eraseEntry(int i) {
+        std::memmove(&entries[i], &entries[i + 1], sizeof(PendingEntry) * (entryCount - i - 1));
+        --entryCount;
+    }
+
+    void addGone(int base, bool moved) {
+        int i = goneCount;
+        while (i > 0 && gone[i - 1].base > base) --i;
+        std::memmove(&gone[i + 1], &gone[i], sizeof(GoneNode) * (goneCount - i));
+        gone[i] = {base, moved, nullptr, nullptr};
+        ++goneCount;
+    }
+
+    GoneNode& findGone(int base) {
+        int lo = 0, hi = goneCount - 1;
+        while (gone[(lo + hi) / 2].base != base) {
+            if (gone[(lo + hi) / 2].base < base) lo = (lo + hi) / 2 + 1;
+            else hi = (lo + hi) / 2 - 1;
+        }
+        return gone[(lo + hi) / 2];
+    }
+
+    // Links `e` in at *link and returns the link after it. A moved node that
+    // the walk has not reached yet gets a stand-in that takes its value later.
+    Node** emit(Node** link, const PendingEntry& e) {
+        Node* n;
+        if (e.base < 0) {
+            n = new Node(e.value, *link);
+        } else {
+            GoneNode& d = findGone(e.base);
+            if (d.node) {
+                n = d.node;
+                n->next = *link;
+            } else {
+                n = d.stand = new Node(0, *link);
+            }
+        }
+        *link = n;
+        return &n->next;
+    }
+
+    int limit;
+    int queued;     // ops since the last flush
+    int baseLen;    // length of the flushed list
+    int entryCount;
+    int goneCount;
+    PendingEntry* entries; // list order
+    GoneNode* gone;        // sorted by base
+};
+
+/* ─── Main ────────────────────────────────────────────────────────── */
+
+static void printUsage(const char* prog) {
+    std::fprintf(stderr, "Usage: %s TRACE_FILE [--impl NAME|all] [--batch N]\n", prog);
+    std::fprintf(stderr, "  NAME is one of:");
+    for (int i = 0; i < kAdapterCount; ++i) std::fprintf(stderr, " %s", kAdapterNames[i]);
+    std::fprintf(stderr, "\n");
+}
+
+static void printRow(const char* engine, const char* impl, long long ops, const ReplayResult& r) {
+    std::printf("%-8s %-12s %12.0f %9.3f %10d  %016llx\n", engine, impl,
+                r.secs > 0 ? ops / r.secs : 0.0, r.secs, r.size, r.checksum);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    const char* path = argv[1];
+    const char* impl = "ChatGPTPaid";
+    int batch = 64;
+    for (int i = 2; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 2;
+        }
+        if (std::strcmp(argv[i], "--impl") == 0) {
+            impl = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--batch") == 0) {
+            batch = std::atoi(argv[i + 1]);
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (batch < 1) batch = 1;
+
+    TraceOp* ops = nullptr;
+    long long count = loadTrace(path, ops);
+    if (count < 0) return 1;
+    std::printf("Trace %s: %lld ops\n\n", path, count);
+    std::printf("%-8s %-12s %12s %9s %10s  %s\n", "engine", "impl", "ops/sec", "secs", "size", "checksum");
+
+    auto runNaive = [&](auto& list) {
+        printRow("naive", list.name, count, replayNaive(list, ops, count));
+    };
+    for (int i = 0; i < kAdapterCount; ++i) {
+        const char* name = kAdapterNames[i];
+        if (std::strcmp(impl, "all") != 0 && std::strcmp(impl, name) != 0) continue;
+        runIsolated(name, [&] { withAdapter(name, runNaive); });
+    }
+    if (std::strcmp(impl, "all") != 0 && !withAdapter(impl, [](auto&) {})) {
+        printUsage(argv[0]);
+        delete[] ops;
+        return 2;
+    }
+
+    BatchedReplayer batched(batch);
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < count; ++i) batched.apply(ops[i]);
+    batched.flush();
+    auto stop = std::chrono::steady_clock::now();
+    ReplayResult r = {std::chrono::duration<double>(stop - start).count(), batched.len,
+                      chainChecksum(batched.head, &Node::value)};
+    printRow("batched", "ChatGPTPaid", count, r);
+
+    std::printf("\nbatched: %lld ops in %lld flushes (avg run %.1f, limit %d)\n",
+                batched.batchedOps, batched.batches,
+                batched.batches ? static_cast<double>(batched.batchedOps) / batched.batches : 0.0,
+                batch);
+
+    delete[] ops;
+    return 0;
+}
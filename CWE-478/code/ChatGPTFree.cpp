@@ -2,20 +2,55 @@
 #include <cstdlib>
 #include <ctime>
 
-struct Node {
-    int data;
-    Node* next;
+// ---------- Node layouts ----------
+//
+// The list is a template over its payload; the node layout is a second
+// parameter:
+//   NATURAL_NODE     the plain struct; the default
+//   PACKED_NODE      payload and next with no padding between them (an int
+//                    node is 12 bytes, not 16). Opt-in only: next is left
+//                    misaligned, and malloc rounds the node back up to the
+//                    same chunk size anyway.
+//   CACHE_LINE_NODE  each node aligned to its own 64-byte line. Opt-in only:
+//                    with nodes from operator new, the aligned allocation
+//                    costs 80 bytes a node and traversal ran ~2x slower for
+//                    every payload size tried (bench/PayloadLayouts.cpp).
+
+enum NodeLayout { PACKED_NODE, NATURAL_NODE, CACHE_LINE_NODE };
+
+template <typename T, NodeLayout L = NATURAL_NODE>
+struct ListNode {
+    T data;
+    ListNode* next;
 };
 
-class SinglyLinkedList {
+#pragma pack(push, 1)
+template <typename T>
+struct ListNode<T, PACKED_NODE> {
+    T data;
+    ListNode* next;
+};
+#pragma pack(pop)
+
+template <typename T>
+struct alignas(64) ListNode<T, CACHE_LINE_NODE> {
+    T data;
+    ListNode* next;
+};
+
+template <typename T, NodeLayout L = NATURAL_NODE>
+class BasicSinglyLinkedList {
+public:
+    typedef ListNode<T, L> Node;
+
 private:
     Node* head;
     int size;
 
 public:
-    SinglyLinkedList() : head(nullptr), size(0) {}
+    BasicSinglyLinkedList() : head(nullptr), size(0) {}
 
-    ~SinglyLinkedList() {
+    ~BasicSinglyLinkedList() {
         clear();
     }
 
@@ -23,6 +58,19 @@ public:
         return size;
     }
 
+    // For a list kept in ascending order: index of the first node >= value
+    // (size if none). `found` reports whether that node equals value.
+    int lowerBound(const T& value, bool& found) const {
+        int index = 0;
+        Node* current = head;
+        while (current && current->data < value) {
+            current = current->next;
+            index++;
+        }
+        found = (current && current->data == value);
+        return index;
+    }
+
     void clear() {
         while (head != nullptr) {
             Node* temp = head;
@@ -32,7 +80,7 @@ public:
         size = 0;
     }
 
-    void pushBack(int value) {
+    void pushBack(const T& value) {
         Node* newNode = new Node{value, nullptr};
 
         if (!head) {
@@ -46,7 +94,7 @@ public:
         size++;
     }
 
-    void insertAt(int index, int value) {
+    void insertAt(int index, const T& value) {
         if (index < 0) index = 0;
         if (index > size) index = size;
 
@@ -127,6 +175,13 @@ public:
         size++;
     }
 
+    // Hands each payload to fn, front to back, by value.
+    template <typename Fn>
+    void forEachValue(Fn fn) const {
+        for (Node* cur = head; cur; cur = cur->next)
+            fn(cur->data);
+    }
+
     void printList() const {
         Node* current = head;
         while (current) {
@@ -137,6 +192,9 @@ public:
     }
 };
 
+typedef BasicSinglyLinkedList<int> SinglyLinkedList;
+typedef SinglyLinkedList::Node Node;
+
 int main() {
     std::srand(static_cast<unsigned>(std::time(nullptr)));
 
@@ -10,6 +10,9 @@ struct Node {
 };
 
 // ---------- Linked-list helpers (raw pointers only) ----------
+//
+// main() now uses the List overloads below; the position helpers stay as the
+// walk-every-step baseline that bench/LengthBench.cpp measures against.
 
 static int length(Node* head) {
     int n = 0;
@@ -26,12 +29,12 @@ static Node* node_at(Node* head, int index) {
     return head;
 }
 
-static void push_front(Node*& head, int value) {
+[[maybe_unused]] static void push_front(Node*& head, int value) {
     head = new Node(value, head);
 }
 
 // Insert new node with `value` at position `pos` (0..len). pos==0 inserts at front.
-static void insert_at(Node*& head, int pos, int value) {
+[[maybe_unused]] static void insert_at(Node*& head, int pos, int value) {
     if (pos <= 0 || head == nullptr) {
         push_front(head, value);
         return;
@@ -41,7 +44,7 @@ static void insert_at(Node*& head, int pos, int value) {
 }
 
 // Delete node at position `pos` (0..len-1). Assumes list non-empty and pos valid.
-static void delete_at(Node*& head, int pos) {
+[[maybe_unused]] static void delete_at(Node*& head, int pos) {
     if (!head) return;
     if (pos == 0) {
         Node* doomed = head;
@@ -56,7 +59,7 @@ static void delete_at(Node*& head, int pos) {
 }
 
 // Detach node at `pos` and return it (node->next set to nullptr). Assumes valid.
-static Node* detach_at(Node*& head, int pos) {
+[[maybe_unused]] static Node* detach_at(Node*& head, int pos) {
     if (!head) return nullptr;
     if (pos == 0) {
         Node* n = head;
@@ -72,7 +75,7 @@ static Node* detach_at(Node*& head, int pos) {
 }
 
 // Insert an *existing* node (already allocated) at position `pos` (0..len).
-static void insert_node_at(Node*& head, int pos, Node* n) {
+[[maybe_unused]] static void insert_node_at(Node*& head, int pos, Node* n) {
     if (!n) return;
     if (pos <= 0 || head == nullptr) {
         n->next = head;
@@ -92,6 +95,192 @@ static void free_list(Node*& head) {
     }
 }
 
+// ---------- List header: head, tail and size kept in step ----------
+//
+// The helpers above leave counting to the caller, which walks the list with
+// length() to find out. These overloads keep a header current instead:
+// size is O(1), and inserting at pos == size goes through `tail` with no walk.
+
+struct List {
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    int size = 0;
+};
+
+// Insert an existing node at `pos` (0..size); past the end appends.
+static void insert_node_at(List& list, int pos, Node* n) {
+    if (!n) return;
+    if (pos <= 0 || list.head == nullptr) {
+        n->next = list.head;
+        list.head = n;
+        if (!list.tail) list.tail = n;
+    } else {
+        Node* prev = (pos >= list.size) ? list.tail : node_at(list.head, pos - 1);
+        n->next = prev->next;
+        prev->next = n;
+        if (prev == list.tail) list.tail = n;
+    }
+    ++list.size;
+}
+
+static void push_front(List& list, int value) {
+    insert_node_at(list, 0, new Node(value));
+}
+
+static void insert_at(List& list, int pos, int value) {
+    insert_node_at(list, pos, new Node(value));
+}
+
+// Detach node at `pos` (0..size-1) and return it. Assumes valid.
+static Node* detach_at(List& list, int pos) {
+    if (!list.head) return nullptr;
+    Node* prev = nullptr;
+    Node* n;
+    if (pos == 0) {
+        n = list.head;
+        list.head = n->next;
+    } else {
+        prev = node_at(list.head, pos - 1);
+        n = prev->next;
+        prev->next = n->next;
+    }
+    if (n == list.tail) list.tail = prev;
+    n->next = nullptr;
+    --list.size;
+    return n;
+}
+
+static void delete_at(List& list, int pos) {
+    delete detach_at(list, pos);
+}
+
+static void free_list(List& list) {
+    free_list(list.head);
+    list.tail = nullptr;
+    list.size = 0;
+}
+
+// ---------- Deferred reclamation ----------
+//
+// delete_at(list, pos, retired) unlinks the node and parks it on a retire
+// list (its `next` is reused as the link) instead of calling delete, so the
+// operation itself never enters the allocator. The caller frees the batch
+// with retire_flush() at a quiescent point, e.g. between operations once
+// retired.count reaches some threshold.
+
+struct RetireList {
+    Node* head = nullptr;
+    int count = 0;
+};
+
+static void retire(RetireList& retired, Node* n) {
+    if (!n) return;
+    n->next = retired.head;
+    retired.head = n;
+    ++retired.count;
+}
+
+[[maybe_unused]] static void delete_at(List& list, int pos, RetireList& retired) {
+    retire(retired, detach_at(list, pos));
+}
+
+// Frees every retired node; returns how many.
+[[maybe_unused]] static int retire_flush(RetireList& retired) {
+    int freed = retired.count;
+    free_list(retired.head);
+    retired.count = 0;
+    return freed;
+}
+
+// ---------- Bulk helpers: splice, sort, dedupe (no allocation, no STL) ----------
+
+// Links the whole chain first..last in after `pos` (at the front when pos is
+// null) in O(1). The caller already knows `last`, so nothing is walked.
+static void splice_after(Node*& head, Node* pos, Node* first, Node* last) {
+    if (!first) return;
+    if (!pos) {
+        last->next = head;
+        head = first;
+        return;
+    }
+    last->next = pos->next;
+    pos->next = first;
+}
+
+// Cuts the chain after its first n nodes and returns the remainder.
+static Node* split_after(Node* head, long long n) {
+    while (--n > 0 && head) head = head->next;
+    if (!head) return nullptr;
+    Node* rest = head->next;
+    head->next = nullptr;
+    return rest;
+}
+
+// Stable merge of two sorted, null-terminated chains; `tail` gets the last node.
+static Node* merge_runs(Node* a, Node* b, Node*& tail) {
+    Node* head = nullptr;
+    Node** link = &head;
+    tail = nullptr;
+    while (a && b) {
+        Node*& src = (b->value < a->value) ? b : a;
+        *link = src;
+        tail = src;
+        src = src->next;
+        link = &tail->next;
+    }
+    *link = a ? a : b;
+    while (*link) {
+        tail = *link;
+        link = &tail->next;
+    }
+    return head;
+}
+
+// Bottom-up merge sort: O(n log n) comparisons, O(1) extra space, stable.
+// Each pass merges neighbouring runs of `width` nodes and splices the result
+// back in place. Returns the new tail.
+[[maybe_unused]] static Node* sort_list(Node*& head) {
+    long long len = length(head);
+    if (len < 2) return head;
+
+    Node* tail = nullptr;
+    for (long long width = 1; width < len; width *= 2) {
+        Node* prev = nullptr; // tail of the last merged run in this pass
+        Node* cur = head;
+        while (cur) {
+            Node* left = cur;
+            Node* right = split_after(left, width);
+            cur = split_after(right, width);
+
+            Node* run_tail;
+            Node* merged = merge_runs(left, right, run_tail);
+            if (prev) prev->next = cur;
+            else head = cur;
+            splice_after(head, prev, merged, run_tail);
+            prev = run_tail;
+        }
+        tail = prev;
+    }
+    return tail;
+}
+
+// Drops repeated values from a sorted list, keeping the first of each run.
+// Returns how many nodes were freed.
+[[maybe_unused]] static int dedupe_sorted(Node* head) {
+    int removed = 0;
+    while (head && head->next) {
+        if (head->next->value == head->value) {
+            Node* doomed = head->next;
+            head->next = doomed->next;
+            delete doomed;
+            ++removed;
+        } else {
+            head = head->next;
+        }
+    }
+    return removed;
+}
+
 static void print_list(Node* head, int maxItems = 30) {
     std::cout << "[";
     int i = 0;
@@ -123,7 +312,7 @@ int main() {
     // Seed RNG
     std::mt19937 rng(static_cast<unsigned int>(std::time(nullptr)));
 
-    Node* head = nullptr;
+    List list;
 
     // Keep doing random operations until list has exactly 100 nodes.
     // We avoid operations that would make the size exceed 100.
@@ -132,7 +321,7 @@ int main() {
     int steps = 0;
 
     while (true) {
-        int len = length(head);
+        int len = list.size;
         if (len == TARGET) break;
 
         // Choose an operation that is valid for current length and won't exceed 100.
@@ -163,12 +352,11 @@ int main() {
         }
 
         // Execute chosen operation
-        len = length(head); // refresh
         switch (op) {
             case OP_ADD_FRONT: {
                 if (len >= TARGET) break; // safety
                 int value = rand_int(rng, -100000, 100000);
-                push_front(head, value);
+                push_front(list, value);
                 ++steps;
                 break;
             }
@@ -176,7 +364,7 @@ int main() {
             case OP_DELETE_RANDOM: {
                 if (len <= 0) break;
                 int pos = rand_int(rng, 0, len - 1);
-                delete_at(head, pos);
+                delete_at(list, pos);
                 ++steps;
                 break;
             }
@@ -186,7 +374,7 @@ int main() {
                 int value = rand_int(rng, -100000, 100000);
                 // insertion position can be 0..len (len means append)
                 int pos = rand_int(rng, 0, len);
-                insert_at(head, pos, value);
+                insert_at(list, pos, value);
                 ++steps;
                 break;
             }
@@ -195,12 +383,12 @@ int main() {
                 if (len <= 1) break; // moving within 0/1 node list is pointless
                 // pick a source index
                 int from = rand_int(rng, 0, len - 1);
-                Node* moved = detach_at(head, from);
+                Node* moved = detach_at(list, from);
 
                 // after detach, new length is len-1, destination is 0..(len-1)
                 int newLen = len - 1;
                 int to = rand_int(rng, 0, newLen); // allow re-inserting at end
-                insert_node_at(head, to, moved);
+                insert_node_at(list, to, moved);
                 ++steps;
                 break;
             }
@@ -210,10 +398,10 @@ int main() {
         }
 
         // Optional: print progress occasionally
-        int newLen = length(head);
+        int newLen = list.size;
         if (steps % 50 == 0 || newLen == TARGET) {
             std::cout << "Step " << steps << " | len=" << newLen << " | sample ";
-            print_list(head, 20);
+            print_list(list.head, 20);
             std::cout << "\n";
         }
 
@@ -224,10 +412,10 @@ int main() {
         }
     }
 
-    std::cout << "\nDone.\nFinal length = " << length(head) << "\nFinal sample: ";
-    print_list(head, 40);
+    std::cout << "\nDone.\nFinal length = " << list.size << "\nFinal sample: ";
+    print_list(list.head, 40);
     std::cout << "\n";
 
-    free_list(head);
+    free_list(list);
     return 0;
 }
\ No newline at end of file
@@ -40,7 +40,11 @@ public:
     // Operation 2: Delete a random node
     void deleteRandom() {
         if (!head) return;
-        int idx = rand() % size;
+        deleteAt(rand() % size);
+    }
+
+    // Delete the node at idx (0..size-1)
+    void deleteAt(int idx) {
         if (idx == 0) {
             Node* tmp = head;
             head = head->next;
@@ -57,7 +61,11 @@ public:
 
     // Operation 3: Insert a new integer at a random position
     void insertRandom(int val) {
-        int idx = rand() % (size + 1);
+        insertAt(rand() % (size + 1), val);
+    }
+
+    // Insert val so it ends up at idx (0..size)
+    void insertAt(int idx, int val) {
         Node* newNode = new Node(val);
         if (idx == 0) {
             newNode->next = head;
@@ -78,7 +86,11 @@ public:
         int from = rand() % size;
         int to   = rand() % size;
         if (from == to) to = (to + 1) % size;
+        moveAt(from, to);
+    }
 
+    // Unlink the node at 'from' and relink it at index 'to' of the shortened list
+    void moveAt(int from, int to) {
         // Extract node at 'from'
         Node* fromNode = nullptr;
         if (from == 0) {
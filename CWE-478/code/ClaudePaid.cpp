@@ -1,6 +1,10 @@
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
+#include <cstring>
+#include <cstdint>
+#include <new>
+#include <thread>
 
 struct Node {
     int data;
@@ -9,28 +13,229 @@ struct Node {
     Node(int val) : data(val), next(nullptr) {}
 };
 
+// ---------- Hooks ----------
+//
+// Seams for the bench tools, which bring the implementations
+// (bench/OpLog.h, bench/NodeArena.h, bench/Reclaimer.h). main() sets
+// neither and gets the std::cout lines and plain new/delete.
+
+// Receives each operation in place of its std::cout line.
+struct OpSink {
+    virtual ~OpSink() {}
+    virtual void addEnd(int val, int size) = 0;
+    virtual void deleted(int val, int index, int size) = 0;
+    virtual void inserted(int val, int index, int size) = 0;
+    virtual void moved(int val, int fromIndex, int toIndex, int size) = 0;
+    virtual void compacted(int size) = 0;
+};
+
+// Supplies and takes back nodes in place of new/delete. allocate() returns
+// storage for one Node, or nullptr to fall back to new; release() is handed
+// every node the list lets go of, including ones that came from new.
+struct NodeSource {
+    virtual ~NodeSource() {}
+    virtual void* allocate() = 0;
+    virtual void release(Node* n) = 0;
+};
+
+// ---------- Parallel reduction result ----------
+//
+// sum/min/max over a run of nodes plus an order-sensitive polynomial hash
+// (h = h * P + value). Unlike an FNV-1a checksum, two adjacent runs combine
+// in O(log n): h(ab) = h(a) * P^count(b) + h(b), so segments reduced on
+// different threads can be merged in list order.
+
+struct ListSummary {
+    long long count;
+    long long sum;
+    int min;
+    int max;
+    unsigned long long hash;
+
+    static const unsigned long long kPrime = 1099511628211ULL;
+
+    ListSummary() : count(0), sum(0), min(0), max(0), hash(0) {}
+
+    void add(int v) {
+        if (count == 0 || v < min) min = v;
+        if (count == 0 || v > max) max = v;
+        ++count;
+        sum += v;
+        hash = hash * kPrime + static_cast<unsigned int>(v);
+    }
+
+    // Appends the run summarized by `next` after this one.
+    void append(const ListSummary& next) {
+        if (next.count == 0) return;
+        if (count == 0 || next.min < min) min = next.min;
+        if (count == 0 || next.max > max) max = next.max;
+        unsigned long long scale = 1, base = kPrime;
+        for (long long e = next.count; e > 0; e >>= 1) {
+            if (e & 1) scale *= base;
+            base *= base;
+        }
+        hash = hash * scale + next.hash;
+        count += next.count;
+        sum += next.sum;
+    }
+};
+
 class SinglyLinkedList {
 private:
     Node* head;
     int size;
+    bool verbose;   // per-operation trace lines; the driver turns these off
+    OpSink* log;    // when set, trace lines go here instead of std::cout
+    NodeSource* nodes; // when set, nodes come from and go back to it
+
+    // Compaction state. Nodes placed by compact() live in `block`. A deleted
+    // block node's slot goes on blockFree for the next new node, and the
+    // block itself is freed once none of its nodes is left in the list.
+    Node* block;
+    int blockCount;
+    int blockLive;        // block slots holding list nodes
+    Node* blockFree;      // vacated block slots, linked through next
+    int farLinks;         // links whose target is more than a cache line away
+    double compactAt;     // auto-compact when farLinks / links exceeds this; 0 = off
+    int compactMinSize;   // ...and the list has at least this many nodes
+    int compactions;
+
+    // Skip pointers for summarize(): skips[i] is the node at index i * skipEvery.
+    // Any single-node operation clears skipsValid; appendBulk() extends them.
+    Node** skips;
+    int skipCount;
+    int skipCapacity;
+    int skipEvery;
+    bool skipsValid;
+
+    // 1 if following a -> b likely lands on a different cache line.
+    static int far(const Node* a, const Node* b) {
+        if (!a || !b) return 0;
+        std::uintptr_t x = reinterpret_cast<std::uintptr_t>(a);
+        std::uintptr_t y = reinterpret_cast<std::uintptr_t>(b);
+        return (x > y ? x - y : y - x) > 64 ? 1 : 0;
+    }
+
+    bool inBlock(const Node* n) const {
+        std::uintptr_t p = reinterpret_cast<std::uintptr_t>(n);
+        std::uintptr_t lo = reinterpret_cast<std::uintptr_t>(block);
+        return block && p >= lo && p < lo + sizeof(Node) * blockCount;
+    }
+
+    Node* makeNode(int val) {
+        if (blockFree) {
+            Node* slot = blockFree;
+            blockFree = slot->next;
+            blockLive++;
+            return new (slot) Node(val);
+        }
+        if (nodes) {
+            void* slot = nodes->allocate();
+            if (slot) return new (slot) Node(val);
+        }
+        return new Node(val);
+    }
+
+    void releaseNode(Node* n) {
+        if (!inBlock(n)) {
+            if (nodes) nodes->release(n);
+            else delete n;
+            return;
+        }
+        n->next = blockFree;
+        blockFree = n;
+        if (--blockLive == 0) {
+            ::operator delete(block);
+            block = blockFree = nullptr;
+            blockCount = 0;
+        }
+    }
+
+    void maybeCompact() {
+        if (compactAt > 0 && size >= compactMinSize && farLinks > compactAt * (size - 1))
+            compact();
+    }
 
 public:
-    SinglyLinkedList() : head(nullptr), size(0) {}
+    SinglyLinkedList()
+        : head(nullptr), size(0), verbose(true), log(nullptr), nodes(nullptr), block(nullptr), blockCount(0),
+          blockLive(0), blockFree(nullptr), farLinks(0), compactAt(0), compactMinSize(0), compactions(0),
+          skips(nullptr), skipCount(0), skipCapacity(0), skipEvery(4096), skipsValid(true) {}
 
     ~SinglyLinkedList() {
         Node* current = head;
         while (current) {
             Node* temp = current;
             current = current->next;
-            delete temp;
+            releaseNode(temp);
         }
+        ::operator delete(block);
+        delete[] skips;
     }
 
     int getSize() const { return size; }
 
+    void setVerbose(bool on) { verbose = on; }
+
+    void setLog(OpSink* sink) { log = sink; }
+
+    // Take nodes from `source` and give them back to it (it must outlive the
+    // list). Only takes effect on an empty list, so every node's owner stays
+    // known.
+    bool setNodeSource(NodeSource* source) {
+        if (size > 0) return false;
+        nodes = source;
+        return true;
+    }
+
+    // Share of links that jump more than a cache line, kept up to date by
+    // every operation (0 = laid out in list order).
+    double fragmentation() const { return size > 1 ? static_cast<double>(farLinks) / (size - 1) : 0.0; }
+
+    int getCompactions() const { return compactions; }
+
+    // Compact automatically once fragmentation() passes `threshold` on a list
+    // of at least `minSize` nodes; 0 turns it off (the default). A compaction
+    // costs one walk, and since an operation adds at most two far links it
+    // takes at least threshold * size / 2 operations to trigger the next one.
+    void setAutoCompact(double threshold, int minSize = 1024) {
+        compactAt = threshold;
+        compactMinSize = minSize;
+    }
+
+    // Relocates every node into one new contiguous block in list order and
+    // rewires `next`, so a traversal reads memory front to back. The old
+    // nodes (and any previous block) are freed.
+    void compact() {
+        skipsValid = false;
+        Node* fresh = nullptr;
+        if (size > 0) fresh = static_cast<Node*>(::operator new(sizeof(Node) * size));
+        Node* current = head;
+        for (int i = 0; i < size; i++) {
+            Node* placed = new (&fresh[i]) Node(current->data);
+            placed->next = (i + 1 < size) ? &fresh[i + 1] : nullptr;
+            Node* old = current;
+            current = current->next;
+            if (!inBlock(old)) releaseNode(old);
+        }
+        ::operator delete(block);
+        block = fresh;
+        blockCount = size;
+        blockLive = size;
+        blockFree = nullptr;
+        head = fresh;
+        farLinks = 0;
+        compactions++;
+        if (verbose) {
+            if (log) log->compacted(size);
+            else std::cout << "  [COMPACT] Relaid " << size << " nodes contiguously\n";
+        }
+    }
+
     // Operation 1: Add a new integer to the end of the list
     void addToEnd(int val) {
-        Node* newNode = new Node(val);
+        skipsValid = false;
+        Node* newNode = makeNode(val);
         if (!head) {
             head = newNode;
         } else {
@@ -38,56 +243,83 @@ public:
             while (current->next)
                 current = current->next;
             current->next = newNode;
+            farLinks += far(current, newNode);
         }
         size++;
-        std::cout << "  [ADD END] Added " << val << " at the end. Size: " << size << "\n";
+        if (verbose) {
+            if (log) log->addEnd(val, size);
+            else std::cout << "  [ADD END] Added " << val << " at the end. Size: " << size << "\n";
+        }
+        maybeCompact();
     }
 
     // Operation 2: Delete a node at a random index
     bool deleteRandom() {
         if (size == 0) return false;
+        return deleteAt(rand() % size);
+    }
 
-        int index = rand() % size;
+    // Delete the node at index (0..size-1)
+    bool deleteAt(int index) {
+        if (index < 0 || index >= size) return false;
+        skipsValid = false;
         int deletedVal;
 
         if (index == 0) {
             Node* temp = head;
             deletedVal = temp->data;
+            farLinks -= far(temp, temp->next);
             head = head->next;
-            delete temp;
+            releaseNode(temp);
         } else {
             Node* prev = head;
             for (int i = 0; i < index - 1; i++)
                 prev = prev->next;
             Node* temp = prev->next;
             deletedVal = temp->data;
+            farLinks += far(prev, temp->next) - far(prev, temp) - far(temp, temp->next);
             prev->next = temp->next;
-            delete temp;
+            releaseNode(temp);
         }
         size--;
-        std::cout << "  [DELETE]  Removed " << deletedVal << " at index " << index
-                  << ". Size: " << size << "\n";
+        if (verbose) {
+            if (log) log->deleted(deletedVal, index, size);
+            else std::cout << "  [DELETE]  Removed " << deletedVal << " at index " << index
+                           << ". Size: " << size << "\n";
+        }
+        maybeCompact();
         return true;
     }
 
     // Operation 3: Insert a new integer at a random position
     void insertRandom(int val) {
-        int index = (size == 0) ? 0 : rand() % (size + 1);
-        Node* newNode = new Node(val);
+        insertAt((size == 0) ? 0 : rand() % (size + 1), val);
+    }
+
+    // Insert a new integer so it lands at index (0..size)
+    void insertAt(int index, int val) {
+        skipsValid = false;
+        Node* newNode = makeNode(val);
 
         if (index == 0) {
             newNode->next = head;
             head = newNode;
+            farLinks += far(newNode, newNode->next);
         } else {
             Node* current = head;
             for (int i = 0; i < index - 1; i++)
                 current = current->next;
             newNode->next = current->next;
             current->next = newNode;
+            farLinks += far(current, newNode) + far(newNode, newNode->next) - far(current, newNode->next);
         }
         size++;
-        std::cout << "  [INSERT]  Inserted " << val << " at index " << index
-                  << ". Size: " << size << "\n";
+        if (verbose) {
+            if (log) log->inserted(val, index, size);
+            else std::cout << "  [INSERT]  Inserted " << val << " at index " << index
+                           << ". Size: " << size << "\n";
+        }
+        maybeCompact();
     }
 
     // Operation 4: Move a node from one position to another
@@ -98,17 +330,28 @@ public:
         int toIndex = rand() % size;
         while (toIndex == fromIndex)
             toIndex = rand() % size;
+        return moveNode(fromIndex, toIndex);
+    }
+
+    // Move the node at fromIndex so it takes the place of the node currently
+    // at toIndex (0..size). toIndex == size moves it to the end.
+    bool moveNode(int fromIndex, int toIndex) {
+        if (fromIndex < 0 || fromIndex >= size || toIndex < 0 || toIndex > size)
+            return false;
+        skipsValid = false;
 
         // Extract the node at fromIndex
         Node* extracted;
         if (fromIndex == 0) {
             extracted = head;
+            farLinks -= far(extracted, extracted->next);
             head = head->next;
         } else {
             Node* prev = head;
             for (int i = 0; i < fromIndex - 1; i++)
                 prev = prev->next;
             extracted = prev->next;
+            farLinks += far(prev, extracted->next) - far(prev, extracted) - far(extracted, extracted->next);
             prev->next = extracted->next;
         }
         extracted->next = nullptr;
@@ -122,20 +365,165 @@ public:
         if (insertAt == 0) {
             extracted->next = head;
             head = extracted;
+            farLinks += far(extracted, extracted->next);
         } else {
             Node* current = head;
             for (int i = 0; i < insertAt - 1; i++)
                 current = current->next;
             extracted->next = current->next;
             current->next = extracted;
+            farLinks += far(current, extracted) + far(extracted, extracted->next) - far(current, extracted->next);
         }
 
-        std::cout << "  [MOVE]    Moved node with value " << extracted->data
-                  << " from index " << fromIndex << " to index " << toIndex
-                  << ". Size: " << size << "\n";
+        if (verbose) {
+            if (log) log->moved(extracted->data, fromIndex, toIndex, size);
+            else std::cout << "  [MOVE]    Moved node with value " << extracted->data
+                           << " from index " << fromIndex << " to index " << toIndex
+                           << ". Size: " << size << "\n";
+        }
+        maybeCompact();
         return true;
     }
 
+    // Spacing of the skip pointers summarize() splits on; takes effect at the
+    // next rebuild.
+    void setSkipEvery(int every) {
+        skipEvery = every > 0 ? every : 1;
+        skipsValid = false;
+    }
+
+    // Appends values[0..n) in order. `threads` workers each build a disjoint
+    // sublist from one slice of the buffer (and record the skip pointers that
+    // fall in it); the sublists are then stitched onto the tail in O(threads).
+    // Finding the tail is one walk of the existing list. Not traced. With a
+    // node source set the build runs on one thread (sources need not be
+    // thread-safe); parallel workers allocate with new and leave free block
+    // slots alone.
+    void appendBulk(const int* values, int n, int threads) {
+        if (n <= 0) return;
+        if (threads < 1 || nodes) threads = 1;
+        if (threads > n) threads = n;
+
+        Node* tail = head;
+        if (tail)
+            while (tail->next) tail = tail->next;
+
+        // Extend the skip array when the existing skips still describe the list.
+        bool keepSkips = skipsValid || size == 0;
+        if (keepSkips) {
+            int needed = static_cast<int>((static_cast<long long>(size) + n + skipEvery - 1) / skipEvery);
+            if (needed > skipCapacity) {
+                Node** grown = new Node*[needed];
+                if (skipCount > 0) std::memcpy(grown, skips, sizeof(Node*) * skipCount);
+                delete[] skips;
+                skips = grown;
+                skipCapacity = needed;
+            }
+            skipCount = needed;
+        }
+
+        Node** first = new Node*[threads];
+        Node** last = new Node*[threads];
+        int* farCount = new int[threads];
+        const int base = size;
+        auto build = [&](int t) {
+            int lo = static_cast<int>(static_cast<long long>(n) * t / threads);
+            int hi = static_cast<int>(static_cast<long long>(n) * (t + 1) / threads);
+            Node* prev = nullptr;
+            int links = 0;
+            for (int i = lo; i < hi; ++i) {
+                Node* node = threads == 1 ? makeNode(values[i]) : new Node(values[i]);
+                if (prev) {
+                    prev->next = node;
+                    links += far(prev, node);
+                } else {
+                    first[t] = node;
+                }
+                if (keepSkips && (base + i) % skipEvery == 0) skips[(base + i) / skipEvery] = node;
+                prev = node;
+            }
+            last[t] = prev;
+            farCount[t] = links;
+        };
+        std::thread* workers = new std::thread[threads - 1];
+        for (int t = 1; t < threads; ++t) workers[t - 1] = std::thread(build, t);
+        build(0);
+        for (int t = 1; t < threads; ++t) workers[t - 1].join();
+        delete[] workers;
+
+        for (int t = 0; t < threads; ++t) {
+            if (tail) {
+                tail->next = first[t];
+                farLinks += far(tail, first[t]);
+            } else {
+                head = first[t];
+            }
+            tail = last[t];
+            farLinks += farCount[t];
+        }
+        size += n;
+        skipsValid = keepSkips;
+        delete[] first;
+        delete[] last;
+        delete[] farCount;
+        maybeCompact();
+    }
+
+    // Resamples the skip pointers with one walk.
+    void rebuildSkips() {
+        int needed = (size + skipEvery - 1) / skipEvery;
+        if (needed > skipCapacity) {
+            delete[] skips;
+            skips = new Node*[needed];
+            skipCapacity = needed;
+        }
+        skipCount = needed;
+        int i = 0;
+        for (Node* cur = head; cur; cur = cur->next, ++i)
+            if (i % skipEvery == 0) skips[i / skipEvery] = cur;
+        skipsValid = true;
+    }
+
+    // sum/min/max/hash over the whole list on `threads` threads. Each thread
+    // takes a contiguous range of skip pointers and walks from the first one,
+    // so no thread has to walk past another's segment to find its start.
+    // Stale skips (after any single-node operation) are rebuilt first, which
+    // is a serial walk.
+    ListSummary summarize(int threads) {
+        if (!skipsValid) rebuildSkips();
+        if (threads > skipCount) threads = skipCount;
+        if (threads < 1) return ListSummary();
+
+        ListSummary* parts = new ListSummary[threads];
+        auto reduce = [&](int t) {
+            int from = static_cast<int>(static_cast<long long>(skipCount) * t / threads);
+            int to = static_cast<int>(static_cast<long long>(skipCount) * (t + 1) / threads);
+            long long end = static_cast<long long>(to) * skipEvery;
+            if (end > size) end = size;
+            long long remaining = end - static_cast<long long>(from) * skipEvery;
+            ListSummary part;
+            for (Node* cur = skips[from]; remaining > 0; cur = cur->next, --remaining) part.add(cur->data);
+            parts[t] = part;
+        };
+        std::thread* workers = new std::thread[threads - 1];
+        for (int t = 1; t < threads; ++t) workers[t - 1] = std::thread(reduce, t);
+        reduce(0);
+        for (int t = 1; t < threads; ++t) workers[t - 1].join();
+        delete[] workers;
+
+        ListSummary total = parts[0];
+        for (int t = 1; t < threads; ++t) total.append(parts[t]);
+        delete[] parts;
+        return total;
+    }
+
+    // Calls fn(value) for every node in list order; no per-node trace.
+    template <typename Fn>
+    void forEachValue(Fn fn) const {
+        for (Node* cur = head; cur; cur = cur->next)
+            fn(cur->data);
+    }
+
     void print() const {
         std::cout << "\n  List (" << size << " nodes): [";
         Node* current = head;
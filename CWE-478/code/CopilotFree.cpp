@@ -52,11 +52,32 @@ public:
         }
     }
 
+    void removeAt(int position) {
+        if (position < 0 || position >= size) return;
+        Node* temp = head;
+        if (position == 0) {
+            head = head->next;
+        } else {
+            Node* current = head;
+            for (int i = 0; i < position - 1; i++) {
+                current = current->next;
+            }
+            temp = current->next;
+            current->next = temp->next;
+        }
+        delete temp;
+        size--;
+    }
+
     void randomInsert() {
         if (size >= 100) return;
         int randomValue = rand() % 1000;
         int position = rand() % (size + 1);
-        Node* newNode = new Node(randomValue);
+        insertAt(position, randomValue);
+    }
+
+    void insertAt(int position, int value) {
+        Node* newNode = new Node(value);
 
         if (position == 0) {
             newNode->next = head;
@@ -121,6 +142,13 @@ public:
     int getSize() {
         return size;
     }
+
+    // Visits at most `size` values: moveNode() can leave the chain cyclic.
+    template <typename Fn>
+    void forEachValue(Fn fn) const {
+        int n = 0;
+        for (Node* cur = head; cur && n < size; cur = cur->next, ++n) fn(cur->data);
+    }
 };
 
 int main() {
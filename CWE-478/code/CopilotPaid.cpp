@@ -8,8 +8,11 @@ struct Node {
 };
 
 // ---------- Utility: basic list operations (raw pointers only) ----------
+//
+// main() now uses the List overloads below; pushFront/insertAt/deleteAt stay
+// as the walk-every-step baseline that bench/LengthBench.cpp measures against.
 
-static int listLength(Node* head) {
+[[maybe_unused]] static int listLength(Node* head) {
     int n = 0;
     for (Node* cur = head; cur != nullptr; cur = cur->next) ++n;
     return n;
@@ -22,12 +25,12 @@ static Node* nodeAt(Node* head, int index) {
     return cur;
 }
 
-static void pushFront(Node*& head, int value) {
+[[maybe_unused]] static void pushFront(Node*& head, int value) {
     Node* n = new Node{value, head};
     head = n;
 }
 
-static void insertAt(Node*& head, int index, int value) {
+[[maybe_unused]] static void insertAt(Node*& head, int index, int value) {
     // Inserts BEFORE position index, where index is in [0, length]
     // index == 0 => push front
     if (index <= 0 || head == nullptr) {
@@ -41,7 +44,7 @@ static void insertAt(Node*& head, int index, int value) {
     prev->next = n;
 }
 
-static void deleteAt(Node*& head, int index) {
+[[maybe_unused]] static void deleteAt(Node*& head, int index) {
     // Deletes node at index, where index is in [0, length-1]
     if (head == nullptr) return;
 
@@ -59,67 +62,99 @@ static void deleteAt(Node*& head, int index) {
     delete doomed;
 }
 
-static void moveNode(Node*& head, int fromIndex, int toIndex) {
-    // Removes node at fromIndex and reinserts it so it becomes
-    // the node BEFORE the current toIndex position in the *resulting* list.
-    // Indices are interpreted as in a typical "erase then insert" operation.
+static void clearList(Node*& head) {
+    while (head != nullptr) {
+        Node* doomed = head;
+        head = head->next;
+        delete doomed;
+    }
+}
 
-    int len = listLength(head);
-    if (len <= 1) return;
-    if (fromIndex < 0) fromIndex = 0;
-    if (fromIndex >= len) fromIndex = len - 1;
-    if (toIndex < 0) toIndex = 0;
-    if (toIndex > len) toIndex = len; // insertion can be at end
+// ---------- List header: head, tail and size kept together ----------
+//
+// Same operations as above, but the list carries its own length and last
+// node, so callers read `size` instead of re-walking listLength(), and
+// anything landing at the end links through `tail` directly.
 
-    if (fromIndex == toIndex || fromIndex + 1 == toIndex) {
-        // Moving to same spot (or right after itself) is effectively no-op
-        return;
-    }
+struct List {
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    int size = 0;
+};
 
-    // 1) Detach the node at fromIndex
-    Node* moving = nullptr;
+// Node at index-1, i.e. the one a node inserted at `index` follows.
+static Node* nodeBefore(List& list, int index) {
+    return (index >= list.size) ? list.tail : nodeAt(list.head, index - 1);
+}
 
-    if (fromIndex == 0) {
-        moving = head;
-        head = head->next;
+static void linkAt(List& list, int index, Node* n) {
+    if (index <= 0 || list.head == nullptr) {
+        n->next = list.head;
+        list.head = n;
+        if (list.tail == nullptr) list.tail = n;
     } else {
-        Node* prevFrom = nodeAt(head, fromIndex - 1);
-        moving = prevFrom->next;
-        prevFrom->next = moving->next;
+        Node* prev = nodeBefore(list, index);
+        n->next = prev->next;
+        prev->next = n;
+        if (prev == list.tail) list.tail = n;
     }
-    moving->next = nullptr;
-
-    // After removal, list length is len-1.
-    // If we removed an earlier index, the destination shifts left by 1.
-    if (fromIndex < toIndex) toIndex -= 1;
+    ++list.size;
+}
 
-    // 2) Insert moving at toIndex in the shortened list
-    if (toIndex <= 0 || head == nullptr) {
-        moving->next = head;
-        head = moving;
-        return;
+static Node* unlinkAt(List& list, int index) {
+    Node* prev = nullptr;
+    Node* n;
+    if (index <= 0) {
+        n = list.head;
+        list.head = n->next;
+    } else {
+        prev = nodeAt(list.head, index - 1);
+        n = prev->next;
+        prev->next = n->next;
     }
+    if (n == list.tail) list.tail = prev;
+    n->next = nullptr;
+    --list.size;
+    return n;
+}
 
-    int newLen = len - 1;
-    if (toIndex >= newLen) {
-        // Insert at end
-        Node* tail = nodeAt(head, newLen - 1);
-        tail->next = moving;
-        moving->next = nullptr;
-        return;
-    }
+static void pushFront(List& list, int value) {
+    linkAt(list, 0, new Node{value, nullptr});
+}
 
-    Node* prevTo = nodeAt(head, toIndex - 1);
-    moving->next = prevTo->next;
-    prevTo->next = moving;
+static void insertAt(List& list, int index, int value) {
+    // Inserts BEFORE position index, where index is in [0, size]
+    linkAt(list, index, new Node{value, nullptr});
 }
 
-static void clearList(Node*& head) {
-    while (head != nullptr) {
-        Node* doomed = head;
-        head = head->next;
-        delete doomed;
-    }
+static void deleteAt(List& list, int index) {
+    // Deletes node at index, where index is in [0, size-1]
+    if (list.head == nullptr || index >= list.size) return;
+    delete unlinkAt(list, index);
+}
+
+static void moveNode(List& list, int fromIndex, int toIndex) {
+    // Removes node at fromIndex and reinserts it so it becomes
+    // the node BEFORE the current toIndex position in the *resulting* list.
+    // Indices are interpreted as in a typical "erase then insert" operation.
+    int len = list.size;
+    if (len <= 1) return;
+    if (fromIndex < 0) fromIndex = 0;
+    if (fromIndex >= len) fromIndex = len - 1;
+    if (toIndex < 0) toIndex = 0;
+    if (toIndex > len) toIndex = len;
+
+    if (fromIndex == toIndex || fromIndex + 1 == toIndex) return;
+
+    Node* moving = unlinkAt(list, fromIndex);
+    if (fromIndex < toIndex) toIndex -= 1;
+    linkAt(list, toIndex, moving);
+}
+
+static void clearList(List& list) {
+    clearList(list.head);
+    list.tail = nullptr;
+    list.size = 0;
 }
 
 static void printList(Node* head) {
@@ -138,12 +173,10 @@ static int randInt(int lo, int hi) {
     return lo + (std::rand() % (hi - lo + 1));
 }
 
-// ---------- Main: perform random operations until exactly 100 nodes ----------
-
 int main() {
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
 
-    Node* head = nullptr;
+    List list;
 
     const int TARGET = 100;
     int ops = 0;
@@ -151,7 +184,7 @@ int main() {
     // Keep doing random operations until the list has exactly 100 nodes.
     // We bias operations depending on current length so we converge.
     while (true) {
-        int len = listLength(head);
+        int len = list.size;
         if (len == TARGET) break;
 
         // Choose operation:
@@ -181,20 +214,20 @@ int main() {
 
         if (op == 1) {
             int value = randInt(-100000, 100000);
-            pushFront(head, value);
+            pushFront(list, value);
         } else if (op == 2) {
             int idx = randInt(0, len - 1);
-            deleteAt(head, idx);
+            deleteAt(list, idx);
         } else if (op == 3) {
             // Insert at random position in [0, len] (can insert at end)
             int idx = randInt(0, len);
             int value = randInt(-100000, 100000);
-            insertAt(head, idx, value);
+            insertAt(list, idx, value);
         } else if (op == 4) {
             if (len >= 2) {
                 int fromIdx = randInt(0, len - 1);
                 int toIdx = randInt(0, len); // insertion position (can be end)
-                moveNode(head, fromIdx, toIdx);
+                moveNode(list, fromIdx, toIdx);
             }
         }
 
@@ -207,12 +240,12 @@ int main() {
         }
     }
 
-    int finalLen = listLength(head);
+    int finalLen = list.size;
     std::cout << "Done after " << ops << " operations.\n";
     std::cout << "Final length: " << finalLen << "\n";
     // Optional: print the list (100 nodes is fine)
-    printList(head);
+    printList(list.head);
 
-    clearList(head);
+    clearList(list);
     return 0;
 }
\ No newline at end of file
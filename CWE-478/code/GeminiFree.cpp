@@ -31,8 +31,11 @@ public:
     // 2) Delete a random item
     void deleteRandom() {
         if (size == 0) return;
-        int index = rand() % size;
+        deleteAt(rand() % size);
+    }
 
+    // Delete the item at index (0..size-1)
+    void deleteAt(int index) {
         Node* toDelete;
         if (index == 0) {
             toDelete = head;
@@ -49,7 +52,11 @@ public:
 
     // 3) Add a new integer at a random position
     void insertRandom(int val) {
-        int index = (size == 0) ? 0 : rand() % (size + 1);
+        insertAt((size == 0) ? 0 : rand() % (size + 1), val);
+    }
+
+    // Add a new integer at index (0..size)
+    void insertAt(int index, int val) {
         Node* newNode = new Node{val, nullptr};
 
         if (index == 0) {
@@ -69,6 +76,11 @@ public:
         if (size < 2) return;
         int fromIdx = rand() % size;
         int toIdx = rand() % size;
+        moveNode(fromIdx, toIdx);
+    }
+
+    // Move the item at fromIdx to toIdx of the list without it
+    void moveNode(int fromIdx, int toIdx) {
         if (fromIdx == toIdx) return;
 
         // Extract the node
@@ -96,6 +108,12 @@ public:
 
     int getSize() { return size; }
 
+    // Read-only walk for callers outside the class.
+    template <typename Fn>
+    void forEachValue(Fn fn) const {
+        for (Node* cur = head; cur; cur = cur->next) fn(cur->data);
+    }
+
     ~LinkedList() {
         while (head) {
             Node* temp = head;
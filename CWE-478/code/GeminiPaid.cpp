@@ -103,6 +103,12 @@ public:
 
     int getSize() const { return size; }
 
+    // Walks the values head to tail without exposing the nodes.
+    template <typename Fn>
+    void forEachValue(Fn fn) const {
+        for (Node* cur = head; cur; cur = cur->next) fn(cur->data);
+    }
+
     ~SinglyLinkedList() {
         while (head) {
             Node* temp = head;